@@ -0,0 +1,41 @@
+#ifndef RESULT_BENCHMARKS_BENCH_HPP_INCLUDED
+#define RESULT_BENCHMARKS_BENCH_HPP_INCLUDED
+
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+
+//  A deliberately tiny harness; we only want relative numbers
+//  between two approaches in the same binary, so there's no need
+//  to pull in a benchmarking framework.
+namespace bench {
+
+    template<typename T>
+    auto do_not_optimize(T const& value) -> void {
+#if defined(__GNUC__)
+        asm volatile("" : : "g"(&value) : "memory");
+#else
+        static_cast<void>(*static_cast<T const volatile*>(&value));
+#endif
+    }
+
+    template<typename F>
+    auto run(char const* name, size_t iterations, F&& f) -> double {
+        using Clock = std::chrono::steady_clock;
+
+        f();
+
+        auto start = Clock::now();
+        for (size_t i = 0; i < iterations; ++i) {
+            f();
+        }
+        auto elapsed = std::chrono::duration<double, std::micro> {
+            Clock::now() - start };
+
+        auto per_iteration = elapsed.count() / iterations;
+        std::printf("%-48s %12.3f us/iter\n", name, per_iteration);
+        return per_iteration;
+    }
+}
+
+#endif //RESULT_BENCHMARKS_BENCH_HPP_INCLUDED
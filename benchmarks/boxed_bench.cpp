@@ -0,0 +1,76 @@
+#include "bench.hpp"
+#include "result/boxed.hpp"
+#include "result/result.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+    struct RichError {
+        int code;
+        char context[192];
+        std::string message;
+    };
+
+    constexpr size_t count = 1000;
+
+    template<typename R>
+    auto make(uint32_t i, uint32_t error_every) -> R {
+        if (error_every && i % error_every == 0) {
+            return result::err(RichError { static_cast<int>(i), { }, "failed" });
+        }
+        return result::ok(static_cast<int>(i));
+    }
+
+    //  Builds a batch of results and folds over them; the cost is
+    //  dominated by how much memory each `Result` takes.
+    template<typename R>
+    auto run(char const* label, uint32_t error_every) -> void {
+        std::vector<R> results;
+        results.reserve(count);
+
+        char name[64];
+        if (error_every) {
+            std::snprintf(name,
+                          sizeof(name),
+                          "%s, 1 in %u errors",
+                          label,
+                          static_cast<unsigned>(error_every));
+        }
+        else {
+            std::snprintf(name, sizeof(name), "%s, no errors", label);
+        }
+
+        bench::run(name, 2000, [&] {
+            results.clear();
+            for (uint32_t i = 0; i < count; ++i) {
+                results.push_back(make<R>(i, error_every));
+            }
+
+            int64_t sum = 0;
+            for (auto& r : results) {
+                sum += r ? r.value() : r.error().code;
+            }
+            bench::do_not_optimize(sum);
+        });
+    }
+}
+
+auto main(int, char const**) -> int {
+
+    using Inline = result::Result<int, RichError>;
+    using Boxed = result::Result<int, result::Boxed<RichError>>;
+
+    std::printf("sizeof(Result<int, RichError>):        %zu\n",
+                sizeof(Inline));
+    std::printf("sizeof(Result<int, Boxed<RichError>>): %zu\n",
+                sizeof(Boxed));
+
+    for (uint32_t every : { 0u, 1000u, 100u, 10u, 1u }) {
+        run<Inline>("inline", every);
+        run<Boxed>("boxed", every);
+    }
+
+    return 0;
+}
@@ -0,0 +1,177 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+//  Compares the time it takes to compile a set of generated
+//  translation units that use common `Result`s, with and without
+//  `RESULT_EXTERN_TEMPLATES` (see `result/instantiations.hpp`).
+//
+//  Any arguments are passed on to the compiler; e.g. run it with
+//  `-ftime-trace` under Clang to get a per-TU trace to look at.
+//  The compiler and include path are those this benchmark was
+//  configured with.
+namespace {
+
+    constexpr int translation_units = 16;
+    constexpr int groups_per_unit = 8;
+
+    //  Each TU uses the same few `Result`s in slightly different
+    //  ways, like ordinary code would.
+    auto write_tu(std::string const& path, int n) -> bool {
+        auto f = std::fopen(path.c_str(), "w");
+        if (!f) {
+            return false;
+        }
+
+        std::fprintf(f,
+            "#include \"result/result.hpp\"\n"
+            "#include <cstddef>\n"
+            "#include <string>\n"
+            "#include <system_error>\n"
+            "\n"
+            "using Size = result::Result<std::size_t, std::error_code>;\n"
+            "using Text = result::Result<std::string, std::error_code>;\n"
+            "using Unit = result::Result<void, std::error_code>;\n");
+
+        for (int g = n * groups_per_unit;
+             g < (n + 1) * groups_per_unit;
+             ++g)
+        {
+                std::fprintf(f,
+                "\n"
+                "auto produce_%d(std::size_t n) -> Size {\n"
+                "    if (n %% %d == 0) {\n"
+                "        return result::err(\n"
+                "            std::make_error_code(std::errc::invalid_argument));\n"
+                "    }\n"
+                "    return result::ok(n * %d);\n"
+                "}\n"
+                "\n"
+                "auto describe_%d(std::size_t n) -> Text {\n"
+                "    auto r = produce_%d(n);\n"
+                "    auto copy = r;\n"
+                "    if (copy != r) {\n"
+                "        return result::err(std::make_error_code(std::errc::io_error));\n"
+                "    }\n"
+                "    return std::move(r).map([](std::size_t v) {\n"
+                "        return std::to_string(v);\n"
+                "    });\n"
+                "}\n"
+                "\n"
+                "auto check_%d(std::size_t n) -> Unit {\n"
+                "    auto text = describe_%d(n);\n"
+                "    if (!text) {\n"
+                "        return result::err(std::move(text).error());\n"
+                "    }\n"
+                "    return text.value().size() > %d\n"
+                "        ? Unit { result::ok() }\n"
+                "        : Unit { result::err(\n"
+                "              std::make_error_code(std::errc::result_out_of_range)) };\n"
+                "}\n",
+                g, g + 2, g + 1, g, g, g, g, g % 5);
+        }
+
+        return std::fclose(f) == 0;
+    }
+
+    struct Timing {
+        double milliseconds;
+        long long object_bytes;
+    };
+
+    //  Compiles every TU, one after the other. A negative time means
+    //  a compile failed.
+    auto compile_all(std::string const& dir,
+                     std::string const& flags) -> Timing
+    {
+        using Clock = std::chrono::steady_clock;
+
+        auto start = Clock::now();
+        for (int i = 0; i < translation_units; ++i) {
+            auto command =
+                std::string { RESULT_BENCH_CXX } +
+                " -std=c++17 -I" RESULT_BENCH_INCLUDE " " + flags +
+                " -c " + dir + "/tu" + std::to_string(i) + ".cpp" +
+                " -o " + dir + "/tu" + std::to_string(i) + ".o";
+            if (std::system(command.c_str()) != 0) {
+                return { -1.0, 0 };
+            }
+        }
+
+        Timing t {
+            std::chrono::duration<double, std::milli> {
+                Clock::now() - start }.count(),
+            0 };
+
+        for (int i = 0; i < translation_units; ++i) {
+            struct stat st;
+            auto object = dir + "/tu" + std::to_string(i) + ".o";
+            if (::stat(object.c_str(), &st) == 0) {
+                t.object_bytes += st.st_size;
+            }
+        }
+        return t;
+    }
+
+    auto report(char const* name, Timing t) -> void {
+        if (t.milliseconds < 0) {
+            std::printf("%-48s %12s\n", name, "failed");
+            return;
+        }
+        std::printf("%-48s %12.1f ms/TU %8lld KiB of objects\n",
+                    name,
+                    t.milliseconds / translation_units,
+                    t.object_bytes / 1024);
+    }
+}
+
+auto main(int argc, char const** argv) -> int {
+
+    std::string extra;
+    for (int i = 1; i < argc; ++i) {
+        extra += ' ';
+        extra += argv[i];
+    }
+
+    char dir[] = "/tmp/result_compile_time_XXXXXX";
+    if (!::mkdtemp(dir)) {
+        std::perror("mkdtemp");
+        return 1;
+    }
+
+    for (int i = 0; i < translation_units; ++i) {
+        if (!write_tu(std::string { dir } + "/tu" + std::to_string(i) +
+                          ".cpp",
+                      i))
+        {
+            std::perror("write");
+            return 1;
+        }
+    }
+
+    std::printf("%d translation units in %s\n", translation_units, dir);
+
+    for (auto level : { "-O0", "-O2" }) {
+        auto flags = std::string { level } + extra;
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "implicit instantiation, %s", level);
+        report(name, compile_all(dir, flags));
+
+        std::snprintf(name, sizeof(name), "extern templates, %s", level);
+        report(name, compile_all(dir, flags + " -DRESULT_EXTERN_TEMPLATES=1"));
+    }
+
+    for (int i = 0; i < translation_units; ++i) {
+        auto base = std::string { dir } + "/tu" + std::to_string(i);
+        ::unlink((base + ".cpp").c_str());
+        ::unlink((base + ".o").c_str());
+    }
+    ::rmdir(dir);
+
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include "bench.hpp"
+#include "result/fault.hpp"
+#include "result/result.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <system_error>
+
+//  Built with `RESULT_ENABLE_FAULT_INJECTION=1` (see
+//  `benchmarks/CMakeLists.txt`). A build without it compiles `inject`
+//  down to the "no injection" case below.
+
+namespace {
+    using Parsed = result::Result<uint64_t, std::error_code>;
+
+    constexpr size_t calls = 1000;
+
+    auto parse(uint64_t x) -> Parsed {
+        return result::ok(x * 2654435761u);
+    }
+
+    //  Roughly what a caller does with each result: use the value or
+    //  fall back on error.
+    auto consume(Parsed r) -> uint64_t {
+        if (!r) {
+            return static_cast<uint64_t>(r.error().value());
+        }
+        return r.value() >> 3;
+    }
+
+    auto without_injection() -> void {
+        uint64_t sum = 0;
+        for (uint64_t i = 0; i < calls; ++i) {
+            sum += consume(parse(i));
+        }
+        bench::do_not_optimize(sum);
+    }
+
+    auto with_injection() -> void {
+        uint64_t sum = 0;
+        for (uint64_t i = 0; i < calls; ++i) {
+            sum += consume(result::inject<std::error_code>(
+                "bench.parse",
+                parse(i),
+                [] { return std::make_error_code(std::errc::io_error); }));
+        }
+        bench::do_not_optimize(sum);
+    }
+}
+
+auto main(int, char const**) -> int {
+
+    std::printf("%zu calls per iteration\n", calls);
+
+    bench::run("no injection", 2000, without_injection);
+    bench::run("inject, unconfigured site", 2000, with_injection);
+
+    auto& registry = result::fault::Registry::instance();
+    for (int percent = 0; percent <= 100; percent += 10) {
+        registry.configure("bench.parse", percent / 100.0, 1);
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "inject, %d%% errors", percent);
+        bench::run(name, 2000, with_injection);
+    }
+
+    return 0;
+}
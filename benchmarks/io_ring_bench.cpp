@@ -0,0 +1,99 @@
+#include "bench.hpp"
+#include "result/io.hpp"
+#include "result/io_ring.hpp"
+#include "result/result.hpp"
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr size_t kFileSize = 64 << 20;
+    constexpr size_t kBlockSize = 4096;
+    constexpr size_t kReads = 16384;
+    constexpr unsigned kQueueDepth = 64;
+
+    using result::io::IoResult;
+    using result::io::IoRing;
+    using result::io::IoRingBackend;
+    using result::io::ReadRequest;
+
+    auto make_file() -> std::string {
+        char name[] = "/tmp/result_io_ring_bench_XXXXXX";
+        auto fd = ::mkstemp(name);
+        std::vector<char> block(1 << 20, 'x');
+        for (size_t written = 0; written < kFileSize; written += block.size()) {
+            result::io::write_all(fd, block.data(), block.size()).value();
+        }
+        ::close(fd);
+        return name;
+    }
+
+    auto make_requests(int fd, std::vector<char>& buffer)
+        -> std::vector<ReadRequest>
+    {
+        std::minstd_rand rng { 42 };
+        std::uniform_int_distribution<size_t> block {
+            0, kFileSize / kBlockSize - 1 };
+
+        std::vector<ReadRequest> requests;
+        for (size_t i = 0; i < kReads; ++i) {
+            requests.push_back(ReadRequest {
+                fd,
+                buffer.data() + (i % kQueueDepth) * kBlockSize,
+                kBlockSize,
+                static_cast<off_t>(block(rng) * kBlockSize),
+                i });
+        }
+        return requests;
+    }
+
+    auto run_ring(char const* name,
+                  IoRingBackend backend,
+                  std::vector<ReadRequest> const& requests) -> void
+    {
+        auto ring = IoRing::create(kQueueDepth, backend);
+        if (!ring) {
+            std::printf("%-48s unavailable: %s\n",
+                        name,
+                        ring.error().message().c_str());
+            return;
+        }
+
+        std::vector<IoResult<size_t>> results(
+            requests.size(), result::ok(size_t { 0 }));
+
+        bench::run(name, 10, [&] {
+            auto r = ring.value().read_batch(requests.data(),
+                                             requests.size(),
+                                             results.data());
+            bench::do_not_optimize(r.is_ok());
+        });
+    }
+}
+
+auto main(int, char const**) -> int {
+
+    auto path = make_file();
+    auto fd = result::io::open(path.c_str(), O_RDONLY).value();
+    std::vector<char> buffer(kQueueDepth * kBlockSize);
+    auto requests = make_requests(fd.get(), buffer);
+
+    std::printf("%zu random %zu byte reads from a cached %zu MiB file\n",
+                kReads, kBlockSize, kFileSize >> 20);
+
+    bench::run("synchronous pread", 10, [&] {
+        size_t total = 0;
+        for (auto const& r : requests) {
+            total += result::io::pread(r.fd, r.buffer, r.length, r.offset)
+                .value();
+        }
+        bench::do_not_optimize(total);
+    });
+
+    run_ring("IoRing (io_uring), depth 64", IoRingBackend::IoUring, requests);
+    run_ring("IoRing (threads), depth 64", IoRingBackend::Threads, requests);
+
+    ::unlink(path.c_str());
+    return 0;
+}
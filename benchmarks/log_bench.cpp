@@ -0,0 +1,96 @@
+#include "bench.hpp"
+#include "result/log.hpp"
+#include "result/result.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <system_error>
+
+namespace {
+    constexpr size_t count = 1000;
+    constexpr size_t iterations = 2000;
+
+    auto fails(uint32_t i) -> result::Result<int, std::error_code> {
+        return result::err(std::error_code {
+            static_cast<int>(i % 8) + 1, std::generic_category() });
+    }
+
+    //  What logging usually looks like: format the error right
+    //  there, on the thread that hit it.
+    auto log_sync(result::Result<int, std::error_code> const& r) -> void {
+        if (!r) {
+            char line[256];
+            auto message = r.error().message();
+            auto n = std::snprintf(line,
+                                   sizeof(line),
+                                   "request: %s:%d: %s\n",
+                                   r.error().category().name(),
+                                   r.error().value(),
+                                   message.c_str());
+            bench::do_not_optimize(line);
+            bench::do_not_optimize(n);
+        }
+    }
+}
+
+//  Every call fails, so this is the cost of logging on the thread
+//  that returned the error. The sink discards what it formats, and
+//  its own thread never wakes up to drain, so only the caller's work
+//  is timed.
+auto main(int, char const**) -> int {
+
+    result::ErrorSink::Options options;
+    options.buffer_entries = 4 * count;
+    options.lines_per_second = 1000000;
+    options.burst = 1000000;
+    options.poll_interval = std::chrono::hours { 1 };
+    options.write = [](char const*, size_t) { };
+    result::ErrorSink sink { std::move(options) };
+
+    bench::run("no logging, 100% errors", iterations, [&] {
+        for (uint32_t i = 0; i < count; ++i) {
+            auto r = fails(i);
+            bench::do_not_optimize(r);
+        }
+    });
+
+    bench::run("format in place, 100% errors", iterations, [&] {
+        for (uint32_t i = 0; i < count; ++i) {
+            auto r = fails(i);
+            log_sync(r);
+            bench::do_not_optimize(r);
+        }
+    });
+
+    //  Each batch is drained, on this thread, after it's been timed,
+    //  so the buffer never fills and nothing is dropped.
+    using Clock = std::chrono::steady_clock;
+    auto caller = Clock::duration::zero();
+    size_t batches = 0;
+    bench::run("log_err + drain, 100% errors", iterations, [&] {
+        auto start = Clock::now();
+        for (uint32_t i = 0; i < count; ++i) {
+            auto r = fails(i);
+            result::log_err(r, sink, "request");
+            bench::do_not_optimize(r);
+        }
+        caller += Clock::now() - start;
+        ++batches;
+        sink.flush();
+    });
+
+    //  `bench::run` also calls us once to warm up, hence counting.
+    std::printf("%-48s %12.3f us/iter\n",
+                "log_err, caller only, 100% errors",
+                std::chrono::duration<double, std::micro> { caller }.count() /
+                    batches);
+
+    auto stats = sink.stats();
+    std::printf("logged %llu, written %llu, dropped %llu\n",
+                static_cast<unsigned long long>(stats.logged),
+                static_cast<unsigned long long>(stats.written),
+                static_cast<unsigned long long>(stats.dropped));
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include "bench.hpp"
+#include "result/memo_cache.hpp"
+#include "result/result.hpp"
+#include <cstdint>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace {
+    using Lookup = result::Result<uint64_t, std::error_code>;
+    using Cache = result::MemoCache<uint64_t, uint64_t, std::error_code>;
+
+    //  Stands in for an expensive lookup against a local table;
+    //  every 10th key fails.
+    auto expensive_lookup(uint64_t key) -> Lookup {
+        uint64_t h = key;
+        for (int i = 0; i < 2000; ++i) {
+            h = h * 6364136223846793005ull + 1442695040888963407ull;
+        }
+        if (key % 10 == 0) {
+            return result::err(
+                std::make_error_code(std::errc::no_such_device_or_address));
+        }
+        return result::ok(h);
+    }
+
+    template<typename F>
+    auto hammer(size_t threads, size_t lookups, F&& f) -> void {
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                uint64_t sum = 0;
+                for (size_t i = 0; i < lookups; ++i) {
+                    auto r = f((i * 7 + t) % 1024);
+                    sum += r.is_ok() ? r.value() : 1;
+                }
+                bench::do_not_optimize(sum);
+            });
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+    }
+}
+
+auto main(int, char const**) -> int {
+
+    constexpr size_t kLookups = 100000;
+    constexpr size_t kIterations = 5;
+
+    auto threads = std::thread::hardware_concurrency();
+    if (threads < 2) {
+        threads = 4;
+    }
+
+    std::printf("threads: %u\n", threads);
+
+    bench::run("uncached lookups", kIterations, [&] {
+        hammer(threads, kLookups, expensive_lookup);
+    });
+
+    for (size_t shards : { 1, 16, 64 }) {
+        Cache::Options options;
+        options.shards = shards;
+        Cache cache { expensive_lookup, options };
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "MemoCache, %zu shard(s)", shards);
+        bench::run(name, kIterations, [&] {
+            hammer(threads, kLookups, [&](uint64_t key) {
+                return cache.get(key);
+            });
+        });
+
+        auto stats = cache.stats();
+        std::printf("    hits: %llu misses: %llu coalesced: %llu\n",
+                    static_cast<unsigned long long>(stats.hits),
+                    static_cast<unsigned long long>(stats.misses),
+                    static_cast<unsigned long long>(stats.coalesced));
+    }
+
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include "bench.hpp"
+#include "result/ranges.hpp"
+#include "result/result.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+    using Record = result::Result<uint64_t, std::string>;
+
+    auto make_records(size_t count) -> std::vector<Record> {
+        std::vector<Record> records;
+        records.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            if (i % 7 == 0) {
+                records.push_back(result::err(std::string { "bad record" }));
+            }
+            else {
+                records.push_back(result::ok(static_cast<uint64_t>(i)));
+            }
+        }
+        return records;
+    }
+}
+
+auto main(int, char const**) -> int {
+
+    constexpr size_t kRecords = 1000000;
+    constexpr size_t kIterations = 20;
+
+    auto records = make_records(kRecords);
+
+    bench::run("eager: copy ok values, transform, sum", kIterations, [&] {
+        std::vector<uint64_t> oks;
+        for (auto& r : records) {
+            if (r.is_ok()) {
+                oks.push_back(r.value());
+            }
+        }
+
+        std::vector<uint64_t> doubled;
+        for (auto v : oks) {
+            doubled.push_back(v * 2);
+        }
+
+        uint64_t sum = 0;
+        for (auto v : doubled) {
+            sum += v;
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    bench::run("lazy: transform_ok | filter_ok, sum", kIterations, [&] {
+        uint64_t sum = 0;
+        auto values = records
+            | result::transform_ok([](uint64_t v) { return v * 2; })
+            | result::filter_ok();
+
+        for (auto v : values) {
+            sum += v;
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    bench::run("eager: collect errors", kIterations, [&] {
+        std::vector<std::string const*> errors;
+        for (auto& r : records) {
+            if (!r.is_ok()) {
+                errors.push_back(&r.error());
+            }
+        }
+        bench::do_not_optimize(errors.size());
+    });
+
+    bench::run("lazy: errors_only", kIterations, [&] {
+        size_t count = 0;
+        for (auto& e : records | result::errors_only()) {
+            count += e.size();
+        }
+        bench::do_not_optimize(count);
+    });
+
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include "bench.hpp"
+#include "result/relocate.hpp"
+#include "result/result.hpp"
+#include <memory>
+#include <system_error>
+#include <vector>
+
+namespace {
+    struct Payload {
+        int value;
+    };
+
+    using Element = result::Result<std::unique_ptr<Payload>, std::error_code>;
+
+    auto make_element(size_t i) -> Element {
+        if (i % 16 == 0) {
+            return result::err(
+                std::make_error_code(std::errc::invalid_argument));
+        }
+        return result::ok(std::make_unique<Payload>(
+            Payload { static_cast<int>(i) }));
+    }
+
+    template<typename Vector>
+    auto grow(size_t count) -> void {
+        Vector v;
+        for (size_t i = 0; i < count; ++i) {
+            v.push_back(make_element(i));
+        }
+        bench::do_not_optimize(v.data());
+    }
+
+    template<typename Vector>
+    auto erase_front(size_t count) -> void {
+        Vector v;
+        for (size_t i = 0; i < count; ++i) {
+            v.push_back(make_element(i));
+        }
+        while (!v.empty()) {
+            v.erase(v.begin());
+        }
+        bench::do_not_optimize(v.data());
+    }
+}
+
+auto main(int, char const**) -> int {
+
+    constexpr size_t kGrowElements = 1000000;
+    constexpr size_t kEraseElements = 4000;
+    constexpr size_t kIterations = 10;
+
+    bench::run("std::vector<Result> growth", kIterations, [] {
+        grow<std::vector<Element>>(kGrowElements);
+    });
+
+    bench::run("RelocatingVector<Result> growth", kIterations, [] {
+        grow<result::RelocatingVector<Element>>(kGrowElements);
+    });
+
+    bench::run("std::vector<Result> erase front", kIterations, [] {
+        erase_front<std::vector<Element>>(kEraseElements);
+    });
+
+    bench::run("RelocatingVector<Result> erase front", kIterations, [] {
+        erase_front<result::RelocatingVector<Element>>(kEraseElements);
+    });
+
+    return 0;
+}
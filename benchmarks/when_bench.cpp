@@ -0,0 +1,66 @@
+#include "bench.hpp"
+#include "result/result.hpp"
+#include "result/when.hpp"
+#include <cstdint>
+#include <system_error>
+#include <utility>
+
+namespace {
+    using Step = result::Result<uint64_t, std::error_code>;
+
+    template<size_t I>
+    auto make_step() {
+        return []() -> Step {
+            uint64_t h = I;
+            for (int i = 0; i < 200; ++i) {
+                h = h * 6364136223846793005ull + 1442695040888963407ull;
+            }
+            return result::ok(h);
+        };
+    }
+
+    template<size_t... Is>
+    auto fan_out(result::WorkStealingPool& pool, std::index_sequence<Is...>)
+        -> void
+    {
+        auto r = result::when_all(pool, make_step<Is>()...);
+        bench::do_not_optimize(r.is_ok());
+    }
+
+    template<size_t... Is>
+    auto sequential(std::index_sequence<Is...>) -> void {
+        uint64_t sum = 0;
+        int const steps[] = { (sum += make_step<Is>()().value(), 0)... };
+        static_cast<void>(steps);
+        bench::do_not_optimize(sum);
+    }
+
+    template<size_t N>
+    auto run_width(result::WorkStealingPool& pool) -> void {
+        char name[64];
+        std::snprintf(name, sizeof(name), "when_all, width %zu", N);
+        bench::run(name, 2000, [&] {
+            fan_out(pool, std::make_index_sequence<N>{});
+        });
+
+        std::snprintf(name, sizeof(name), "sequential, width %zu", N);
+        bench::run(name, 2000, [] {
+            sequential(std::make_index_sequence<N>{});
+        });
+    }
+}
+
+auto main(int, char const**) -> int {
+
+    result::WorkStealingPool pool;
+    std::printf("pool threads: %zu\n", pool.size());
+
+    run_width<2>(pool);
+    run_width<4>(pool);
+    run_width<8>(pool);
+    run_width<16>(pool);
+    run_width<32>(pool);
+    run_width<64>(pool);
+
+    return 0;
+}
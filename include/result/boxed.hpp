@@ -0,0 +1,220 @@
+#ifndef RESULT_BOXED_HPP_INCLUDED
+#define RESULT_BOXED_HPP_INCLUDED
+
+#include "result/result.hpp"
+#include "result/traits.hpp"
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+//  Out-of-line storage for large, rarely seen errors.
+//
+//  A `Result`'s storage is as big as the larger of its value and
+//  error, so a `Result<int, RichError>` with a 200 byte `RichError`
+//  costs 200+ bytes on every call, error or not. Declaring it as a
+//  `Result<int, Boxed<RichError>>` keeps the error on the heap, in a
+//  pool, and the `Result` down to about `sizeof(int)` plus a
+//  pointer. `error()` still returns a `RichError&`, and `map_err`,
+//  `or_else` and friends are still given a `RichError`.
+//
+//  `CompactResult<T, E>` boxes `E` only when it's much larger than
+//  `T`.
+namespace result {
+
+    namespace detail {
+
+        //  A per-thread cache of freed blocks of one size, so that
+        //  erroring in a loop doesn't go back to the global allocator
+        //  each time. Blocks freed on another thread join that
+        //  thread's cache.
+        template<size_t Size, size_t Align>
+        struct BoxPool {
+
+            static_assert(Align <= alignof(std::max_align_t),
+                          "over-aligned errors can't be boxed");
+
+            static constexpr size_t max_cached = 64;
+
+            static auto allocate() -> void* {
+                auto& cache = local();
+                if (cache.head) {
+                    auto block = cache.head;
+                    cache.head = block->next;
+                    --cache.size;
+                    return block;
+                }
+                return ::operator new(block_size);
+            }
+
+            static auto deallocate(void* p) noexcept -> void {
+                auto& cache = local();
+                if (cache.alive && cache.size < max_cached) {
+                    cache.head = new (p) Block { cache.head };
+                    ++cache.size;
+                    return;
+                }
+                ::operator delete(p);
+            }
+
+        private:
+            struct Block {
+                Block* next;
+            };
+
+            static constexpr size_t block_size =
+                Size > sizeof(Block) ? Size : sizeof(Block);
+
+            struct Cache {
+                ~Cache() {
+                    alive = false;
+                    while (head) {
+                        auto next = head->next;
+                        ::operator delete(head);
+                        head = next;
+                    }
+                    size = 0;
+                }
+
+                Block* head = nullptr;
+                size_t size = 0;
+                bool alive = true;
+            };
+
+            static auto local() -> Cache& {
+                static thread_local Cache cache;
+                return cache;
+            }
+        };
+    }
+
+    //  An owning pointer to a pool allocated `E`. Moving a `Boxed`
+    //  hands its block over rather than allocating a new one, so
+    //  errors are passed along, not re-allocated. Like a moved-from
+    //  `std::unique_ptr`, a moved-from `Boxed` holds nothing: it may
+    //  be destroyed, assigned to, copied or compared, but not
+    //  dereferenced (and neither may the `error()` of a `Result`
+    //  holding it).
+    template<typename E>
+    struct Boxed {
+
+        using Pool = detail::BoxPool<sizeof(E), alignof(E)>;
+
+        Boxed(E&& error) :
+            error_{make(std::move(error))}
+        { }
+
+        Boxed(E const& error) :
+            error_{make(error)}
+        { }
+
+        Boxed(Boxed&& other) noexcept :
+            error_{other.error_}
+        {
+            other.error_ = nullptr;
+        }
+
+        Boxed(Boxed const& other) :
+            error_{other.error_ ? make(*other.error_) : nullptr}
+        { }
+
+        auto operator=(Boxed&& other) noexcept -> Boxed& {
+            std::swap(error_, other.error_);
+            return *this;
+        }
+
+        auto operator=(Boxed const& other) -> Boxed& {
+            if (this != &other) {
+                auto copy = Boxed { other };
+                std::swap(error_, copy.error_);
+            }
+            return *this;
+        }
+
+        ~Boxed() {
+            if (error_) {
+                error_->~E();
+                Pool::deallocate(error_);
+            }
+        }
+
+        auto get() noexcept -> E& { return *error_; }
+        auto get() const noexcept -> E const& { return *error_; }
+
+        auto operator*() noexcept -> E& { return *error_; }
+        auto operator*() const noexcept -> E const& { return *error_; }
+
+        auto operator->() noexcept -> E* { return error_; }
+        auto operator->() const noexcept -> E const* { return error_; }
+
+        //  Empty (moved-from) `Boxed`s are only equal to each other.
+        friend auto operator==(Boxed const& lhs, Boxed const& rhs) -> bool {
+            if (!lhs.error_ || !rhs.error_) {
+                return lhs.error_ == rhs.error_;
+            }
+            return *lhs.error_ == *rhs.error_;
+        }
+
+        friend auto operator!=(Boxed const& lhs, Boxed const& rhs) -> bool {
+            return !(lhs == rhs);
+        }
+
+    private:
+        template<typename U>
+        static auto make(U&& error) -> E* {
+            auto p = Pool::allocate();
+            try {
+                return new (p) E{std::forward<U>(error)};
+            }
+            catch (...) {
+                Pool::deallocate(p);
+                throw;
+            }
+        }
+
+        E* error_;
+    };
+
+    namespace detail {
+        template<typename E>
+        struct ErrorAccess<Boxed<E>> {
+            using type = E;
+
+            static auto get(Boxed<E>& e) noexcept -> E& { return *e; }
+        };
+    }
+
+    namespace traits {
+
+        //  Whether `CompactResult<T, E>` boxes `E`: when it's more
+        //  than twice the size of `T` (or of a pointer, for small
+        //  `T`s).
+        template<typename T, typename E>
+        struct should_box_error :
+            std::integral_constant<
+                bool,
+                (sizeof(E) > 2 * (sizeof(T) > sizeof(void*)
+                                      ? sizeof(T)
+                                      : sizeof(void*)))>
+        { };
+
+        template<typename E>
+        struct should_box_error<void, E> :
+            std::integral_constant<bool, (sizeof(E) > 2 * sizeof(void*))>
+        { };
+
+        template<typename E>
+        struct is_trivially_relocatable<Boxed<E>> : std::true_type
+        { };
+    }
+
+    template<typename T, typename E>
+    using CompactResult = Result<
+        T,
+        typename std::conditional<
+            traits::should_box_error<T, E>::value,
+            Boxed<E>,
+            E>::type>;
+}
+
+#endif //RESULT_BOXED_HPP_INCLUDED
@@ -0,0 +1,222 @@
+#ifndef RESULT_FAULT_HPP_INCLUDED
+#define RESULT_FAULT_HPP_INCLUDED
+
+#include "result/result.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <utility>
+
+#ifndef RESULT_ENABLE_FAULT_INJECTION
+#define RESULT_ENABLE_FAULT_INJECTION 0
+#endif
+
+//  Deterministic fault injection for exercising error paths.
+//
+//  Wrap a fallible call's return value...
+//
+//      return result::inject<std::error_code>("db.read", read(...), [] {
+//          return std::make_error_code(std::errc::io_error);
+//      });
+//
+//  ...and, when built with `RESULT_ENABLE_FAULT_INJECTION=1`, a
+//  configured fraction of the successes at that site become errors.
+//  Otherwise `inject` just returns its argument.
+//
+//  Sites are configured through `fault::Registry::instance()`, or
+//  with the `RESULT_FAULTS` environment variable, read once at
+//  start up, e.g. `RESULT_FAULTS="db.read=0.25,cache.get=0.01@7"`
+//  (`site=rate[@seed]`).
+namespace result { namespace fault {
+
+    struct Registry {
+
+        static constexpr size_t max_sites = 64;
+        static constexpr size_t max_name = 63;
+
+        static auto instance() -> Registry& {
+            static Registry registry { FromEnvironment{} };
+            return registry;
+        }
+
+        //  Makes `rate` (0.0 to 1.0) of the successes at `site`
+        //  fail. The same `seed` gives the same sequence of faults.
+        auto configure(char const* site, double rate, uint64_t seed = 0)
+            -> bool
+        {
+            if (std::strlen(site) > max_name) {
+                return false;
+            }
+
+            std::lock_guard<std::mutex> lock { mutex_ };
+            auto s = find(site);
+            if (!s) {
+                auto n = count_.load(std::memory_order_relaxed);
+                if (n == max_sites) {
+                    return false;
+                }
+                s = &sites_[n];
+                std::strcpy(s->name, site);
+                s->configure(rate, seed);
+                count_.store(n + 1, std::memory_order_release);
+                return true;
+            }
+
+            s->configure(rate, seed);
+            return true;
+        }
+
+        //  Stops injecting faults anywhere. Sites stay registered,
+        //  with a rate of zero.
+        auto clear() -> void {
+            std::lock_guard<std::mutex> lock { mutex_ };
+            auto n = count_.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < n; ++i) {
+                sites_[i].configure(0.0, 0);
+            }
+        }
+
+        //  Decides whether the next call at `site` should fail.
+        auto should_fail(char const* site) -> bool {
+            auto s = find(site);
+            return s && s->next();
+        }
+
+        //  How many faults have been injected at `site`.
+        auto injected(char const* site) -> uint64_t {
+            auto s = find(site);
+            return s ? s->injected.load(std::memory_order_relaxed) : 0;
+        }
+
+    private:
+        struct FromEnvironment { };
+
+        struct Site {
+            char name[max_name + 1];
+            std::atomic<uint64_t> threshold { 0 };
+            std::atomic<uint64_t> seed { 0 };
+            std::atomic<uint64_t> counter { 0 };
+            std::atomic<uint64_t> injected { 0 };
+
+            auto configure(double rate, uint64_t s) -> void {
+                rate = rate < 0.0 ? 0.0 : rate > 1.0 ? 1.0 : rate;
+                //  `threshold` of all-ones means "always". The scale
+                //  is the largest `double` below 2^64, so the
+                //  conversion can't overflow.
+                threshold.store(
+                    rate >= 1.0
+                        ? UINT64_MAX
+                        : static_cast<uint64_t>(
+                            rate * 18446744073709549568.0),
+                    std::memory_order_relaxed);
+                seed.store(s, std::memory_order_relaxed);
+                counter.store(0, std::memory_order_relaxed);
+            }
+
+            auto next() -> bool {
+                auto t = threshold.load(std::memory_order_relaxed);
+                if (!t) {
+                    return false;
+                }
+
+                auto n = counter.fetch_add(1, std::memory_order_relaxed);
+                auto fail = t == UINT64_MAX ||
+                    mix(seed.load(std::memory_order_relaxed) + n) < t;
+                if (fail) {
+                    injected.fetch_add(1, std::memory_order_relaxed);
+                }
+                return fail;
+            }
+
+            //  splitmix64's finalizer; cheap and well distributed.
+            static auto mix(uint64_t x) -> uint64_t {
+                x += 0x9e3779b97f4a7c15ull;
+                x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+                x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+                return x ^ (x >> 31);
+            }
+        };
+
+        explicit Registry(FromEnvironment) {
+            auto spec = std::getenv("RESULT_FAULTS");
+            if (spec) {
+                parse(spec);
+            }
+        }
+
+        //  `site=rate[@seed]` entries separated by commas; malformed
+        //  entries are ignored.
+        auto parse(char const* spec) -> void {
+            while (*spec) {
+                auto end = std::strchr(spec, ',');
+                auto len = end ? static_cast<size_t>(end - spec)
+                               : std::strlen(spec);
+
+                char entry[128];
+                if (len < sizeof(entry)) {
+                    std::memcpy(entry, spec, len);
+                    entry[len] = '\0';
+
+                    auto eq = std::strchr(entry, '=');
+                    if (eq) {
+                        *eq = '\0';
+                        char* rest = nullptr;
+                        auto rate = std::strtod(eq + 1, &rest);
+                        uint64_t seed = 0;
+                        if (rest && *rest == '@') {
+                            seed = std::strtoull(rest + 1, nullptr, 10);
+                        }
+                        configure(entry, rate, seed);
+                    }
+                }
+
+                spec += len;
+                if (*spec == ',') {
+                    ++spec;
+                }
+            }
+        }
+
+        auto find(char const* site) -> Site* {
+            auto n = count_.load(std::memory_order_acquire);
+            for (size_t i = 0; i < n; ++i) {
+                if (std::strcmp(sites_[i].name, site) == 0) {
+                    return &sites_[i];
+                }
+            }
+            return nullptr;
+        }
+
+        std::mutex mutex_;
+        std::atomic<size_t> count_ { 0 };
+        Site sites_[max_sites];
+    };
+}
+
+#if RESULT_ENABLE_FAULT_INJECTION
+    //  The inline namespaces keep translation units built with and
+    //  without fault injection from violating the ODR.
+    inline namespace fault_injection_enabled {
+        template<typename E, typename T, typename F>
+        auto inject(char const* site, Result<T, E>&& r, F&& make_error)
+            -> Result<T, E>
+        {
+            if (r.is_ok() && fault::Registry::instance().should_fail(site)) {
+                return result::err(std::forward<F>(make_error)());
+            }
+            return std::move(r);
+        }
+    }
+#else
+    inline namespace fault_injection_disabled {
+        template<typename E, typename T, typename F>
+        auto inject(char const*, Result<T, E>&& r, F&&) -> Result<T, E> {
+            return std::move(r);
+        }
+    }
+#endif
+}
+
+#endif //RESULT_FAULT_HPP_INCLUDED
@@ -0,0 +1,52 @@
+#ifndef RESULT_INSTANTIATIONS_HPP_INCLUDED
+#define RESULT_INSTANTIATIONS_HPP_INCLUDED
+
+#include "result/result.hpp"
+#include <cstddef>
+#include <string>
+#include <system_error>
+
+//  Explicit instantiations of commonly used `Result`s.
+//
+//  `RESULT_EXTERN_TEMPLATE(T, E)` tells every translation unit that
+//  sees it not to instantiate `Result<T, E>`'s (non-template)
+//  members itself; `RESULT_INSTANTIATE_TEMPLATE(T, E)`, in exactly
+//  one source file, provides them. Use the `_VOID` forms for
+//  `Result<void, E>`. Arguments containing commas need an alias.
+//
+//  Linking `Result::instantiations` (configure with
+//  `-DRESULT_BUILD_INSTANTIATIONS=ON`) defines
+//  `RESULT_EXTERN_TEMPLATES=1`, which makes `result/result.hpp`
+//  declare the pairs in `RESULT_COMMON_INSTANTIATIONS` extern, and
+//  supplies their instantiations.
+#define RESULT_EXTERN_TEMPLATE(T, E)                                    \
+    extern template struct ::result::detail::Storage<T, E>;             \
+    extern template struct ::result::Result<T, E>
+
+#define RESULT_INSTANTIATE_TEMPLATE(T, E)                               \
+    template struct ::result::detail::Storage<T, E>;                    \
+    template struct ::result::Result<T, E>
+
+#define RESULT_EXTERN_TEMPLATE_VOID(E)                                  \
+    extern template struct ::result::detail::Storage<                   \
+        ::result::detail::VoidType, E>;                                 \
+    extern template struct ::result::Result<void, E>
+
+#define RESULT_INSTANTIATE_TEMPLATE_VOID(E)                             \
+    template struct ::result::detail::Storage<                          \
+        ::result::detail::VoidType, E>;                                 \
+    template struct ::result::Result<void, E>
+
+#define RESULT_COMMON_INSTANTIATIONS(X, X_VOID)                         \
+    X(std::size_t, std::error_code);                                    \
+    X(int, std::error_code);                                            \
+    X(bool, std::error_code);                                           \
+    X(std::string, std::error_code);                                    \
+    X_VOID(std::error_code)
+
+#if RESULT_EXTERN_TEMPLATES
+RESULT_COMMON_INSTANTIATIONS(RESULT_EXTERN_TEMPLATE,
+                             RESULT_EXTERN_TEMPLATE_VOID);
+#endif
+
+#endif //RESULT_INSTANTIATIONS_HPP_INCLUDED
@@ -0,0 +1,363 @@
+#ifndef RESULT_IO_HPP_INCLUDED
+#define RESULT_IO_HPP_INCLUDED
+
+#include "result/result.hpp"
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+//  Thin wrappers over the POSIX I/O calls that report failure as a
+//  `Result<..., std::error_code>` rather than `-1` and `errno`.
+//  Calls interrupted by a signal (`EINTR`) are restarted.
+namespace result { namespace io {
+
+    template<typename T>
+    using IoResult = Result<T, std::error_code>;
+
+    namespace detail {
+        inline auto last_error() -> std::error_code {
+            return std::error_code { errno, std::system_category() };
+        }
+
+        //  Calls `f` until it doesn't fail with `EINTR`.
+        template<typename F>
+        auto restart_on_eintr(F&& f) -> decltype(f()) {
+            decltype(f()) rc;
+            do {
+                rc = f();
+            } while (rc == -1 && errno == EINTR);
+            return rc;
+        }
+
+        inline auto to_size_result(ssize_t rc) -> IoResult<size_t> {
+            if (rc < 0) {
+                return result::err(last_error());
+            }
+            return result::ok(static_cast<size_t>(rc));
+        }
+    }
+
+    //  An owned file descriptor; closed on destruction.
+    struct FileDescriptor {
+
+        FileDescriptor() noexcept = default;
+
+        explicit FileDescriptor(int fd) noexcept :
+            fd_{fd}
+        { }
+
+        FileDescriptor(FileDescriptor&& other) noexcept :
+            fd_{other.release()}
+        { }
+
+        FileDescriptor(FileDescriptor const&) = delete;
+
+        auto operator=(FileDescriptor&& other) noexcept
+            -> FileDescriptor&
+        {
+            if (this != &other) {
+                close();
+                fd_ = other.release();
+            }
+            return *this;
+        }
+
+        auto operator=(FileDescriptor const&) -> FileDescriptor& = delete;
+
+        ~FileDescriptor() {
+            close();
+        }
+
+        auto get() const noexcept -> int { return fd_; }
+
+        auto release() noexcept -> int {
+            auto fd = fd_;
+            fd_ = -1;
+            return fd;
+        }
+
+        //  `EINTR` isn't retried here; on Linux the descriptor is
+        //  released regardless and retrying could close a
+        //  descriptor that's since been reused.
+        auto close() noexcept -> IoResult<void> {
+            if (fd_ < 0) {
+                return result::ok();
+            }
+
+            auto rc = ::close(release());
+            if (rc < 0 && errno != EINTR) {
+                return result::err(detail::last_error());
+            }
+            return result::ok();
+        }
+
+        explicit operator bool() const noexcept { return fd_ >= 0; }
+
+    private:
+        int fd_ = -1;
+    };
+
+    inline auto open(char const* path, int flags, mode_t mode = 0)
+        -> IoResult<FileDescriptor>
+    {
+        auto fd = detail::restart_on_eintr([&] {
+            return ::open(path, flags | O_CLOEXEC, mode);
+        });
+
+        if (fd < 0) {
+            return result::err(detail::last_error());
+        }
+        return result::ok(FileDescriptor { fd });
+    }
+
+    //  A single `read(2)`; may return fewer than `n` bytes (and `0`
+    //  at end of file). See `read_all` for a loop over short reads.
+    inline auto read(int fd, void* buffer, size_t n) -> IoResult<size_t> {
+        return detail::to_size_result(detail::restart_on_eintr([&] {
+            return ::read(fd, buffer, n);
+        }));
+    }
+
+    inline auto pread(int fd, void* buffer, size_t n, off_t offset)
+        -> IoResult<size_t>
+    {
+        return detail::to_size_result(detail::restart_on_eintr([&] {
+            return ::pread(fd, buffer, n, offset);
+        }));
+    }
+
+    inline auto readv(int fd, iovec const* iov, int count)
+        -> IoResult<size_t>
+    {
+        return detail::to_size_result(detail::restart_on_eintr([&] {
+            return ::readv(fd, iov, count);
+        }));
+    }
+
+    inline auto write(int fd, void const* buffer, size_t n)
+        -> IoResult<size_t>
+    {
+        return detail::to_size_result(detail::restart_on_eintr([&] {
+            return ::write(fd, buffer, n);
+        }));
+    }
+
+    inline auto writev(int fd, iovec const* iov, int count)
+        -> IoResult<size_t>
+    {
+        return detail::to_size_result(detail::restart_on_eintr([&] {
+            return ::writev(fd, iov, count);
+        }));
+    }
+
+    //  Reads until `n` bytes have been read or end of file is
+    //  reached, so a result less than `n` always means end of file.
+    inline auto read_all(int fd, void* buffer, size_t n)
+        -> IoResult<size_t>
+    {
+        auto out = static_cast<char*>(buffer);
+        size_t total = 0;
+        while (total < n) {
+            auto r = io::read(fd, out + total, n - total);
+            if (!r) {
+                return r;
+            }
+            if (r.value() == 0) {
+                break;
+            }
+            total += r.value();
+        }
+        return result::ok(total);
+    }
+
+    inline auto pread_all(int fd, void* buffer, size_t n, off_t offset)
+        -> IoResult<size_t>
+    {
+        auto out = static_cast<char*>(buffer);
+        size_t total = 0;
+        while (total < n) {
+            auto r = io::pread(fd,
+                               out + total,
+                               n - total,
+                               offset + static_cast<off_t>(total));
+            if (!r) {
+                return r;
+            }
+            if (r.value() == 0) {
+                break;
+            }
+            total += r.value();
+        }
+        return result::ok(total);
+    }
+
+    //  Writes all `n` bytes, looping over short writes.
+    inline auto write_all(int fd, void const* buffer, size_t n)
+        -> IoResult<size_t>
+    {
+        auto in = static_cast<char const*>(buffer);
+        size_t total = 0;
+        while (total < n) {
+            auto r = io::write(fd, in + total, n - total);
+            if (!r) {
+                return r;
+            }
+            total += r.value();
+        }
+        return result::ok(total);
+    }
+
+    inline auto fstat(int fd) -> IoResult<struct stat> {
+        struct stat st;
+        if (::fstat(fd, &st) < 0) {
+            return result::err(detail::last_error());
+        }
+        return result::ok(st);
+    }
+
+    inline auto mmap(void* address,
+                     size_t length,
+                     int protection,
+                     int flags,
+                     int fd,
+                     off_t offset) -> IoResult<void*>
+    {
+        auto p = ::mmap(address, length, protection, flags, fd, offset);
+        if (p == MAP_FAILED) {
+            return result::err(detail::last_error());
+        }
+        return result::ok(p);
+    }
+
+    inline auto munmap(void* address, size_t length) -> IoResult<void> {
+        if (::munmap(address, length) < 0) {
+            return result::err(detail::last_error());
+        }
+        return result::ok();
+    }
+
+    //  A non-owning, contiguous view of bytes.
+    struct ByteView {
+        auto data() const noexcept -> uint8_t const* { return data_; }
+        auto size() const noexcept -> size_t { return size_; }
+        auto empty() const noexcept -> bool { return size_ == 0; }
+
+        auto begin() const noexcept -> uint8_t const* { return data_; }
+        auto end() const noexcept -> uint8_t const* {
+            return data_ + size_;
+        }
+
+        auto operator[](size_t n) const noexcept -> uint8_t {
+            return data_[n];
+        }
+
+        uint8_t const* data_;
+        size_t size_;
+    };
+
+    //  A whole file mapped read-only into memory. Reading through
+    //  `view()` involves no copies and no further system calls.
+    struct MappedFile {
+
+        static auto open(char const* path) -> IoResult<MappedFile> {
+            return io::open(path, O_RDONLY)
+                .and_then([](FileDescriptor fd) {
+                    return map(fd.get());
+                });
+        }
+
+        //  Maps the file open as `fd`; the mapping doesn't need `fd`
+        //  to stay open.
+        static auto map(int fd) -> IoResult<MappedFile> {
+            auto st = io::fstat(fd);
+            if (!st) {
+                return result::err(std::move(st).error());
+            }
+
+            auto size = static_cast<size_t>(st.value().st_size);
+            if (size == 0) {
+                return result::ok(MappedFile { nullptr, 0 });
+            }
+
+            return io::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0)
+                .map([size](void* p) {
+                    return MappedFile { p, size };
+                });
+        }
+
+        MappedFile(MappedFile&& other) noexcept :
+            address_{other.address_}
+        ,   size_{other.size_}
+        ,   mapped_{other.mapped_}
+        {
+            other.address_ = nullptr;
+            other.size_ = 0;
+            other.mapped_ = false;
+        }
+
+        MappedFile(MappedFile const&) = delete;
+
+        auto operator=(MappedFile&& other) noexcept -> MappedFile& {
+            if (this != &other) {
+                unmap();
+                address_ = other.address_;
+                size_ = other.size_;
+                mapped_ = other.mapped_;
+                other.address_ = nullptr;
+                other.size_ = 0;
+                other.mapped_ = false;
+            }
+            return *this;
+        }
+
+        auto operator=(MappedFile const&) -> MappedFile& = delete;
+
+        ~MappedFile() {
+            unmap();
+        }
+
+        auto size() const noexcept -> size_t { return size_; }
+
+        //  Fails with `EBADF` if this file has been moved from.
+        auto view() const -> IoResult<ByteView> {
+            if (!mapped_) {
+                return result::err(
+                    std::error_code { EBADF, std::system_category() });
+            }
+            return result::ok(ByteView {
+                static_cast<uint8_t const*>(address_), size_ });
+        }
+
+    private:
+        MappedFile(void* address, size_t size) noexcept :
+            address_{address}
+        ,   size_{size}
+        ,   mapped_{true}
+        { }
+
+        auto unmap() noexcept -> void {
+            if (address_) {
+                static_cast<void>(io::munmap(address_, size_));
+            }
+            address_ = nullptr;
+            size_ = 0;
+            mapped_ = false;
+        }
+
+        void* address_ = nullptr;
+        size_t size_ = 0;
+        //  Empty files are valid but have nothing to map.
+        bool mapped_ = false;
+    };
+}}
+
+#endif //RESULT_IO_HPP_INCLUDED
@@ -0,0 +1,597 @@
+#ifndef RESULT_IO_RING_HPP_INCLUDED
+#define RESULT_IO_RING_HPP_INCLUDED
+
+#include "result/io.hpp"
+#include "result/result.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define RESULT_HAS_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#endif
+#endif
+
+#ifndef RESULT_HAS_IO_URING
+#define RESULT_HAS_IO_URING 0
+#endif
+
+//  Batched reads whose completions are delivered as
+//  `Result<size_t, std::error_code>`s. On Linux this talks to
+//  io_uring directly (no liburing); where that's unavailable (old
+//  kernels, seccomp, other platforms) a small pool of threads
+//  calling `pread` stands in. Neither allocates per operation.
+namespace result { namespace io {
+
+    struct ReadRequest {
+        int fd;
+        void* buffer;
+        //  At most `IoRing::max_read_length`.
+        size_t length;
+        off_t offset;
+        //  The index of the element of the `results` array passed to
+        //  `IoRing::wait` that receives this read's outcome.
+        size_t id;
+    };
+
+    enum class IoRingBackend {
+        Auto,
+        IoUring,
+        Threads
+    };
+
+    namespace detail {
+        inline auto completion_result(int64_t res) -> IoResult<size_t> {
+            if (res < 0) {
+                return result::err(std::error_code {
+                    static_cast<int>(-res), std::system_category() });
+            }
+            return result::ok(static_cast<size_t>(res));
+        }
+
+        struct RingBackend {
+            virtual ~RingBackend() = default;
+
+            virtual auto submit(ReadRequest const* requests, size_t count)
+                -> IoResult<size_t> = 0;
+
+            virtual auto wait(IoResult<size_t>* results,
+                              size_t min_complete) -> IoResult<size_t> = 0;
+        };
+
+#if RESULT_HAS_IO_URING
+        struct UringBackend : RingBackend {
+
+            static auto create(unsigned entries)
+                -> IoResult<std::unique_ptr<RingBackend>>
+            {
+                io_uring_params params;
+                std::memset(&params, 0, sizeof(params));
+
+                auto fd = static_cast<int>(
+                    ::syscall(__NR_io_uring_setup, entries, &params));
+                if (fd < 0) {
+                    return result::err(last_error());
+                }
+
+                std::unique_ptr<UringBackend> ring {
+                    new UringBackend { FileDescriptor { fd }, params } };
+
+                auto supported = ring->supports_read();
+                if (!supported) {
+                    return result::err(std::move(supported).error());
+                }
+
+                auto mapped = ring->map_rings();
+                if (!mapped) {
+                    return result::err(std::move(mapped).error());
+                }
+
+                return result::ok(
+                    std::unique_ptr<RingBackend> { std::move(ring) });
+            }
+
+            ~UringBackend() {
+                if (sqes_) {
+                    static_cast<void>(
+                        io::munmap(sqes_, sqes_size_));
+                }
+                if (cq_ring_ && cq_ring_ != sq_ring_) {
+                    static_cast<void>(
+                        io::munmap(cq_ring_, cq_ring_size_));
+                }
+                if (sq_ring_) {
+                    static_cast<void>(
+                        io::munmap(sq_ring_, sq_ring_size_));
+                }
+            }
+
+            auto submit(ReadRequest const* requests, size_t count)
+                -> IoResult<size_t> override
+            {
+                auto tail = *sq_tail_;
+                auto head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+                auto free_slots = static_cast<size_t>(
+                    params_.sq_entries - (tail - head));
+                auto n = std::min(count, free_slots);
+
+                for (size_t i = 0; i < n; ++i) {
+                    auto index = tail & *sq_mask_;
+                    auto& sqe = sqes_[index];
+                    std::memset(&sqe, 0, sizeof(sqe));
+                    sqe.opcode = IORING_OP_READ;
+                    sqe.fd = requests[i].fd;
+                    sqe.addr = reinterpret_cast<uintptr_t>(
+                        requests[i].buffer);
+                    //  `IoRing::submit` has checked that it fits.
+                    sqe.len = static_cast<uint32_t>(requests[i].length);
+                    sqe.off = static_cast<uint64_t>(requests[i].offset);
+                    sqe.user_data = requests[i].id;
+                    sq_array_[index] = index;
+                    ++tail;
+                }
+
+                __atomic_store_n(sq_tail_, tail, __ATOMIC_RELEASE);
+
+                size_t submitted = 0;
+                while (submitted < n) {
+                    auto rc = enter(static_cast<unsigned>(n - submitted),
+                                    0,
+                                    0);
+                    if (!rc) {
+                        //  Take back the entries the kernel didn't
+                        //  consume (without SQPOLL it only reads the
+                        //  queue inside `enter`), so that everything
+                        //  in flight is counted by the caller.
+                        __atomic_store_n(
+                            sq_tail_,
+                            static_cast<unsigned>(tail - (n - submitted)),
+                            __ATOMIC_RELEASE);
+                        if (submitted) {
+                            return result::ok(submitted);
+                        }
+                        return rc;
+                    }
+                    submitted += rc.value();
+                }
+                return result::ok(n);
+            }
+
+            auto wait(IoResult<size_t>* results, size_t min_complete)
+                -> IoResult<size_t> override
+            {
+                size_t harvested = 0;
+                for (;;) {
+                    auto head = *cq_head_;
+                    auto tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+                    while (head != tail) {
+                        auto const& cqe = cqes_[head & *cq_mask_];
+                        results[cqe.user_data] = completion_result(cqe.res);
+                        ++head;
+                        ++harvested;
+                    }
+                    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+
+                    if (harvested >= min_complete) {
+                        return result::ok(harvested);
+                    }
+
+                    auto rc = enter(0,
+                                    static_cast<unsigned>(
+                                        min_complete - harvested),
+                                    IORING_ENTER_GETEVENTS);
+                    if (!rc) {
+                        return rc;
+                    }
+                }
+            }
+
+        private:
+            UringBackend(FileDescriptor fd, io_uring_params params) :
+                fd_{std::move(fd)}
+            ,   params_(params)
+            { }
+
+            //  Kernels from 5.1 to 5.5 set up rings but don't have
+            //  `IORING_OP_READ`, and every read would fail with
+            //  `EINVAL`. They also predate `IORING_REGISTER_PROBE`, so
+            //  a failed probe means the same thing.
+            auto supports_read() -> IoResult<void> {
+                alignas(io_uring_probe) unsigned char buffer[
+                    sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op)];
+                std::memset(buffer, 0, sizeof(buffer));
+                auto probe = reinterpret_cast<io_uring_probe*>(buffer);
+
+                auto rc = ::syscall(__NR_io_uring_register,
+                                    fd_.get(),
+                                    IORING_REGISTER_PROBE,
+                                    probe,
+                                    256);
+                if (rc < 0 ||
+                    probe->last_op < IORING_OP_READ ||
+                    !(probe->ops[IORING_OP_READ].flags &
+                        IO_URING_OP_SUPPORTED))
+                {
+                    return result::err(
+                        std::make_error_code(std::errc::not_supported));
+                }
+                return result::ok();
+            }
+
+            auto enter(unsigned to_submit,
+                       unsigned min_complete,
+                       unsigned flags) -> IoResult<size_t>
+            {
+                for (;;) {
+                    auto rc = ::syscall(__NR_io_uring_enter,
+                                        fd_.get(),
+                                        to_submit,
+                                        min_complete,
+                                        flags,
+                                        nullptr,
+                                        0);
+                    if (rc >= 0) {
+                        return result::ok(static_cast<size_t>(rc));
+                    }
+                    if (errno != EINTR) {
+                        return result::err(last_error());
+                    }
+                }
+            }
+
+            auto map_rings() -> IoResult<void> {
+                sq_ring_size_ = params_.sq_off.array +
+                    params_.sq_entries * sizeof(unsigned);
+                cq_ring_size_ = params_.cq_off.cqes +
+                    params_.cq_entries * sizeof(io_uring_cqe);
+
+                auto single = (params_.features & IORING_FEAT_SINGLE_MMAP) != 0;
+                if (single) {
+                    sq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+                }
+
+                auto sq = io::mmap(nullptr,
+                                   sq_ring_size_,
+                                   PROT_READ | PROT_WRITE,
+                                   MAP_SHARED | MAP_POPULATE,
+                                   fd_.get(),
+                                   IORING_OFF_SQ_RING);
+                if (!sq) {
+                    return result::err(std::move(sq).error());
+                }
+                sq_ring_ = static_cast<char*>(sq.value());
+
+                if (single) {
+                    cq_ring_ = sq_ring_;
+                }
+                else {
+                    auto cq = io::mmap(nullptr,
+                                       cq_ring_size_,
+                                       PROT_READ | PROT_WRITE,
+                                       MAP_SHARED | MAP_POPULATE,
+                                       fd_.get(),
+                                       IORING_OFF_CQ_RING);
+                    if (!cq) {
+                        return result::err(std::move(cq).error());
+                    }
+                    cq_ring_ = static_cast<char*>(cq.value());
+                }
+
+                sqes_size_ = params_.sq_entries * sizeof(io_uring_sqe);
+                auto sqes = io::mmap(nullptr,
+                                     sqes_size_,
+                                     PROT_READ | PROT_WRITE,
+                                     MAP_SHARED | MAP_POPULATE,
+                                     fd_.get(),
+                                     IORING_OFF_SQES);
+                if (!sqes) {
+                    return result::err(std::move(sqes).error());
+                }
+                sqes_ = static_cast<io_uring_sqe*>(sqes.value());
+
+                auto at = [](char* base, uint32_t offset) {
+                    return reinterpret_cast<unsigned*>(base + offset);
+                };
+
+                sq_head_ = at(sq_ring_, params_.sq_off.head);
+                sq_tail_ = at(sq_ring_, params_.sq_off.tail);
+                sq_mask_ = at(sq_ring_, params_.sq_off.ring_mask);
+                sq_array_ = at(sq_ring_, params_.sq_off.array);
+                cq_head_ = at(cq_ring_, params_.cq_off.head);
+                cq_tail_ = at(cq_ring_, params_.cq_off.tail);
+                cq_mask_ = at(cq_ring_, params_.cq_off.ring_mask);
+                cqes_ = reinterpret_cast<io_uring_cqe*>(
+                    cq_ring_ + params_.cq_off.cqes);
+
+                return result::ok();
+            }
+
+            FileDescriptor fd_;
+            io_uring_params params_;
+            char* sq_ring_ = nullptr;
+            char* cq_ring_ = nullptr;
+            io_uring_sqe* sqes_ = nullptr;
+            size_t sq_ring_size_ = 0;
+            size_t cq_ring_size_ = 0;
+            size_t sqes_size_ = 0;
+            unsigned* sq_head_ = nullptr;
+            unsigned* sq_tail_ = nullptr;
+            unsigned* sq_mask_ = nullptr;
+            unsigned* sq_array_ = nullptr;
+            unsigned* cq_head_ = nullptr;
+            unsigned* cq_tail_ = nullptr;
+            unsigned* cq_mask_ = nullptr;
+            io_uring_cqe* cqes_ = nullptr;
+        };
+#endif
+
+        //  Worker threads calling `pread`. Requests and completions
+        //  are kept in fixed-size rings sized for the ring's
+        //  capacity, so nothing is allocated after construction.
+        struct ThreadBackend : RingBackend {
+
+            struct Completion {
+                size_t id;
+                int64_t res;
+            };
+
+            ThreadBackend(size_t entries, size_t threads) :
+                pending_(entries)
+            ,   done_(entries)
+            {
+                for (size_t i = 0; i < threads; ++i) {
+                    workers_.emplace_back([this] { run(); });
+                }
+            }
+
+            ~ThreadBackend() {
+                {
+                    std::lock_guard<std::mutex> lock { mutex_ };
+                    stopping_ = true;
+                }
+                work_.notify_all();
+                for (auto& w : workers_) {
+                    w.join();
+                }
+            }
+
+            auto submit(ReadRequest const* requests, size_t count)
+                -> IoResult<size_t> override
+            {
+                size_t n = 0;
+                {
+                    std::lock_guard<std::mutex> lock { mutex_ };
+                    n = std::min(count, pending_.size() - in_flight_);
+                    for (size_t i = 0; i < n; ++i) {
+                        pending_[(pending_head_ + pending_count_) %
+                                 pending_.size()] = requests[i];
+                        ++pending_count_;
+                    }
+                    in_flight_ += n;
+                }
+                work_.notify_all();
+                return result::ok(n);
+            }
+
+            auto wait(IoResult<size_t>* results, size_t min_complete)
+                -> IoResult<size_t> override
+            {
+                size_t harvested = 0;
+                std::unique_lock<std::mutex> lock { mutex_ };
+                for (;;) {
+                    while (done_count_) {
+                        auto const& c = done_[done_head_];
+                        results[c.id] = completion_result(c.res);
+                        done_head_ = (done_head_ + 1) % done_.size();
+                        --done_count_;
+                        --in_flight_;
+                        ++harvested;
+                    }
+
+                    if (harvested >= min_complete) {
+                        return result::ok(harvested);
+                    }
+
+                    completed_.wait(lock, [this] { return done_count_ > 0; });
+                }
+            }
+
+        private:
+            auto run() -> void {
+                std::unique_lock<std::mutex> lock { mutex_ };
+                for (;;) {
+                    work_.wait(lock, [this] {
+                        return stopping_ || pending_count_ > 0;
+                    });
+
+                    if (!pending_count_) {
+                        return;
+                    }
+
+                    auto request = pending_[pending_head_];
+                    pending_head_ = (pending_head_ + 1) % pending_.size();
+                    --pending_count_;
+
+                    lock.unlock();
+                    auto r = io::pread(request.fd,
+                                       request.buffer,
+                                       request.length,
+                                       request.offset);
+                    auto res = r.is_ok()
+                        ? static_cast<int64_t>(r.value())
+                        : -static_cast<int64_t>(r.error().value());
+                    lock.lock();
+
+                    done_[(done_head_ + done_count_) % done_.size()] =
+                        Completion { request.id, res };
+                    ++done_count_;
+                    completed_.notify_all();
+                }
+            }
+
+            std::mutex mutex_;
+            std::condition_variable work_;
+            std::condition_variable completed_;
+            std::vector<ReadRequest> pending_;
+            size_t pending_head_ = 0;
+            size_t pending_count_ = 0;
+            std::vector<Completion> done_;
+            size_t done_head_ = 0;
+            size_t done_count_ = 0;
+            size_t in_flight_ = 0;
+            bool stopping_ = false;
+            std::vector<std::thread> workers_;
+        };
+    }
+
+    struct IoRing {
+
+        //  io_uring takes a 32-bit length. Longer reads are rejected
+        //  by every backend, rather than cut short by one of them;
+        //  Linux returns at most about 2 GiB from a single read
+        //  anyway, so use several requests for more than that.
+        static constexpr size_t max_read_length =
+            std::numeric_limits<uint32_t>::max();
+
+        //  `entries` is the most reads that can be in flight at once.
+        //  With `IoRingBackend::Auto`, io_uring is tried first and
+        //  the thread pool used if it can't be set up or the kernel
+        //  can't do plain reads with it.
+        static auto create(unsigned entries,
+                           IoRingBackend backend = IoRingBackend::Auto)
+            -> IoResult<IoRing>
+        {
+            if (!entries) {
+                return result::err(
+                    std::make_error_code(std::errc::invalid_argument));
+            }
+
+#if RESULT_HAS_IO_URING
+            if (backend != IoRingBackend::Threads) {
+                auto uring = detail::UringBackend::create(entries);
+                if (uring) {
+                    return result::ok(IoRing {
+                        std::move(uring).value(),
+                        IoRingBackend::IoUring,
+                        entries });
+                }
+                if (backend == IoRingBackend::IoUring) {
+                    return result::err(std::move(uring).error());
+                }
+            }
+#else
+            if (backend == IoRingBackend::IoUring) {
+                return result::err(
+                    std::make_error_code(std::errc::not_supported));
+            }
+#endif
+
+            auto threads = std::min<size_t>(
+                entries,
+                std::max(4u, std::thread::hardware_concurrency()));
+            return result::ok(IoRing {
+                std::unique_ptr<detail::RingBackend> {
+                    new detail::ThreadBackend { entries, threads } },
+                IoRingBackend::Threads,
+                entries });
+        }
+
+        auto backend() const noexcept -> IoRingBackend { return kind_; }
+        auto capacity() const noexcept -> size_t { return capacity_; }
+        auto in_flight() const noexcept -> size_t { return in_flight_; }
+
+        //  Queues as many of `requests` as there's capacity for and
+        //  returns how many that was. If the backend fails part way
+        //  through, the ones already queued are reported rather than
+        //  the error; a lasting failure shows up on the next call.
+        //  Queueing also stops at a request longer than
+        //  `max_read_length`, which fails with `EINVAL` once it's
+        //  the first one left.
+        auto submit(ReadRequest const* requests, size_t count)
+            -> IoResult<size_t>
+        {
+            auto n = std::min(count, capacity_ - in_flight_);
+            for (size_t i = 0; i < n; ++i) {
+                if (requests[i].length > max_read_length) {
+                    if (i == 0) {
+                        return result::err(std::make_error_code(
+                            std::errc::invalid_argument));
+                    }
+                    n = i;
+                }
+            }
+            auto r = backend_->submit(requests, n);
+            if (r) {
+                in_flight_ += r.value();
+            }
+            return r;
+        }
+
+        //  Blocks until at least `min_complete` reads (limited to the
+        //  number in flight) have completed, assigning each outcome
+        //  to `results[request.id]`. Returns how many completions
+        //  were harvested, which may be more than `min_complete`.
+        auto wait(IoResult<size_t>* results, size_t min_complete)
+            -> IoResult<size_t>
+        {
+            auto r = backend_->wait(results,
+                                    std::min(min_complete, in_flight_));
+            if (r) {
+                in_flight_ -= r.value();
+            }
+            return r;
+        }
+
+        //  Reads every request, refilling the ring as completions
+        //  arrive. `results` must have an element for each request
+        //  `id`. Fails only if the ring itself does; failures of
+        //  individual reads are reported in `results`.
+        auto read_batch(ReadRequest const* requests,
+                        size_t count,
+                        IoResult<size_t>* results) -> IoResult<void>
+        {
+            size_t queued = 0;
+            while (queued < count || in_flight_) {
+                if (queued < count) {
+                    auto s = submit(requests + queued, count - queued);
+                    if (!s) {
+                        return result::err(std::move(s).error());
+                    }
+                    queued += s.value();
+                }
+
+                auto w = wait(results, 1);
+                if (!w) {
+                    return result::err(std::move(w).error());
+                }
+            }
+            return result::ok();
+        }
+
+    private:
+        IoRing(std::unique_ptr<detail::RingBackend> backend,
+               IoRingBackend kind,
+               size_t capacity) :
+            backend_{std::move(backend)}
+        ,   kind_{kind}
+        ,   capacity_{capacity}
+        { }
+
+        std::unique_ptr<detail::RingBackend> backend_;
+        IoRingBackend kind_;
+        size_t capacity_;
+        size_t in_flight_ = 0;
+    };
+}}
+
+#endif //RESULT_IO_RING_HPP_INCLUDED
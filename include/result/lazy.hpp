@@ -0,0 +1,240 @@
+#ifndef RESULT_LAZY_HPP_INCLUDED
+#define RESULT_LAZY_HPP_INCLUDED
+
+#include "result/result.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__has_include)
+#if __has_include(<version>)
+#include <version>
+#endif
+#endif
+
+namespace result {
+
+    enum class LazyErrorPolicy {
+        //  An error is kept, just like a success; the factory is
+        //  never called again.
+        Cache,
+        //  An error is handed to the callers that were waiting for
+        //  it, and the next call to `get()` runs the factory again.
+        //  Since another thread may be replacing the error at any
+        //  time, each thread is handed its own reference to it, good
+        //  until that thread's next failed `get()` on a `LazyResult`
+        //  of the same type.
+        Retry
+    };
+
+    //  A `Result` computed on first access by `factory`, exactly once
+    //  no matter how many threads ask for it at the same time. Once
+    //  computed, `get()` is a single acquire load plus a branch.
+    template<
+        typename T,
+        typename E,
+        LazyErrorPolicy Policy = LazyErrorPolicy::Cache>
+    struct LazyResult {
+
+        using result_type = Result<T, E>;
+        using factory_type = std::function<result_type()>;
+
+        explicit LazyResult(factory_type factory) :
+            factory_{std::move(factory)}
+        { }
+
+        LazyResult(LazyResult const&) = delete;
+        auto operator=(LazyResult const&) -> LazyResult& = delete;
+
+        ~LazyResult() {
+            if (state_.load(std::memory_order_acquire) == Ready) {
+                stored()->~result_type();
+            }
+        }
+
+        auto get() -> result_type const& {
+            if (state_.load(std::memory_order_acquire) == Ready) {
+                return *stored();
+            }
+            return get_slow();
+        }
+
+        auto is_initialized() const noexcept -> bool {
+            return state_.load(std::memory_order_acquire) == Ready;
+        }
+
+        //  Returns the cached result, or `nullptr` if there isn't
+        //  one yet. Never calls the factory.
+        auto try_get() const noexcept -> result_type const* {
+            return is_initialized() ? stored() : nullptr;
+        }
+
+    private:
+        using State = uint8_t;
+
+        static constexpr State Empty = 0;
+        static constexpr State Running = 1;
+        static constexpr State Ready = 2;
+        static constexpr State Failed = 3;
+
+        using Retrying = std::integral_constant<
+            bool,
+            Policy == LazyErrorPolicy::Retry>;
+
+        auto stored() const noexcept -> result_type const* {
+            return reinterpret_cast<result_type const*>(&storage_);
+        }
+
+        auto stored() noexcept -> result_type* {
+            return reinterpret_cast<result_type*>(&storage_);
+        }
+
+        auto get_slow() -> result_type const& {
+            for (;;) {
+                auto state = state_.load(std::memory_order_acquire);
+                switch (state) {
+                    case Ready:
+                        return *stored();
+                    case Running:
+                        wait_while_running();
+                        //  Whoever ran the factory may have failed
+                        //  and left the error for us.
+                        state = state_.load(std::memory_order_acquire);
+                        if (state == Failed) {
+                            return last_error(Retrying{});
+                        }
+                        break;
+                    case Empty:
+                    case Failed:
+                        if (state_.compare_exchange_strong(
+                                state,
+                                Running,
+                                std::memory_order_acquire))
+                        {
+                            return run_factory();
+                        }
+                        break;
+                }
+            }
+        }
+
+        auto run_factory() -> result_type const& {
+            try {
+                new (static_cast<void*>(&storage_)) result_type{factory_()};
+            }
+            catch (...) {
+                publish(Empty);
+                throw;
+            }
+
+            return finish(Retrying{});
+        }
+
+        auto finish(std::false_type) -> result_type const& {
+            publish(Ready);
+            return *stored();
+        }
+
+        //  Errors don't stay in `storage_`: the next `get()` would
+        //  construct over them while waiters might still be reading.
+        //  They're moved to `failed_` instead, which waiters share
+        //  under `mutex_`.
+        auto finish(std::true_type) -> result_type const& {
+            if (stored()->is_ok()) {
+                publish(Ready);
+                return *stored();
+            }
+
+            std::shared_ptr<result_type const> error;
+            try {
+                error = std::make_shared<result_type const>(
+                    std::move(*stored()));
+            }
+            catch (...) {
+                stored()->~result_type();
+                publish(Empty);
+                throw;
+            }
+            stored()->~result_type();
+
+            {
+                std::lock_guard<std::mutex> lock { mutex_ };
+                failed_ = error;
+            }
+            publish(Failed);
+            return hold(std::move(error));
+        }
+
+        //  `Failed` is never published with `LazyErrorPolicy::Cache`.
+        auto last_error(std::false_type) -> result_type const& {
+            return *stored();
+        }
+
+        auto last_error(std::true_type) -> result_type const& {
+            std::shared_ptr<result_type const> error;
+            {
+                std::lock_guard<std::mutex> lock { mutex_ };
+                error = failed_;
+            }
+            return hold(std::move(error));
+        }
+
+        //  Keeps the error this thread was handed alive, whatever
+        //  other threads do to `failed_`, so it can be returned by
+        //  reference like a cached result.
+        static auto hold(std::shared_ptr<result_type const> error)
+            -> result_type const&
+        {
+            static thread_local std::shared_ptr<result_type const> held;
+            held = std::move(error);
+            return *held;
+        }
+
+        auto publish(State state) -> void {
+            state_.store(state, std::memory_order_release);
+#if defined(__cpp_lib_atomic_wait)
+            state_.notify_all();
+#else
+            //  Taking the lock orders the store with a waiter that
+            //  has checked the state but not yet started waiting.
+            {
+                std::lock_guard<std::mutex> lock { mutex_ };
+            }
+            running_done_.notify_all();
+#endif
+        }
+
+        auto wait_while_running() -> void {
+#if defined(__cpp_lib_atomic_wait)
+            while (state_.load(std::memory_order_acquire) == Running) {
+                state_.wait(Running, std::memory_order_acquire);
+            }
+#else
+            std::unique_lock<std::mutex> lock { mutex_ };
+            running_done_.wait(lock, [this] {
+                return state_.load(std::memory_order_acquire) != Running;
+            });
+#endif
+        }
+
+        factory_type factory_;
+        std::atomic<State> state_ { Empty };
+        typename std::aligned_storage<
+            sizeof(result_type),
+            alignof(result_type)>::type storage_;
+        std::mutex mutex_;
+        std::shared_ptr<result_type const> failed_;
+#if !defined(__cpp_lib_atomic_wait)
+        std::condition_variable running_done_;
+#endif
+    };
+}
+
+#endif //RESULT_LAZY_HPP_INCLUDED
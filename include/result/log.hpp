@@ -0,0 +1,643 @@
+#ifndef RESULT_LOG_HPP_INCLUDED
+#define RESULT_LOG_HPP_INCLUDED
+
+#include "result/result.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//  Logging `Result` errors without formatting them on the thread
+//  that hit them.
+//
+//      static result::ErrorSink sink;
+//
+//      return handle(request)
+//          .inspect_err(result::log_to(sink, "handle"));
+//
+//  `log_err`/`log_to` copy a small, trivially copyable *summary* of
+//  the error (see `traits::error_summary`) into a buffer owned by
+//  the calling thread; that costs a `memcpy` and never blocks. The
+//  sink's own thread formats and writes the entries, folds runs of
+//  identical errors into one "repeated N times" line, and limits
+//  how many lines a second it writes. When a thread's buffer is
+//  full, its errors are counted and dropped.
+namespace result {
+
+    namespace traits {
+
+        template<typename E>
+        struct always_false : std::false_type
+        { };
+
+        //  How an `E` is logged: `summarize` runs on the thread that
+        //  logs the error and must produce a trivially copyable
+        //  `type` of at most `ErrorSink::max_summary` bytes, which
+        //  is later handed to `format` (on the sink's thread) to
+        //  write at most `n` characters to `out`. Identical
+        //  consecutive summaries are compared bytewise, so they
+        //  shouldn't contain padding.
+        //
+        //  Specialize this for your own error types.
+        template<typename E, typename = void>
+        struct error_summary {
+            static_assert(always_false<E>::value,
+                          "specialize result::traits::error_summary<E> "
+                          "to log this error type");
+        };
+
+        template<typename E>
+        struct error_summary<
+            E,
+            typename std::enable_if<
+                std::is_integral<E>::value ||
+                    std::is_enum<E>::value>::type>
+        {
+            using type = int64_t;
+
+            static auto summarize(E const& e) noexcept -> type {
+                return static_cast<type>(e);
+            }
+
+            static auto format(type const& e, char* out, size_t n)
+                -> size_t
+            {
+                return static_cast<size_t>(std::snprintf(
+                    out, n, "error %lld", static_cast<long long>(e)));
+            }
+        };
+
+        template<>
+        struct error_summary<std::error_code> {
+            struct type {
+                std::error_category const* category;
+                int64_t value;
+            };
+
+            static auto summarize(std::error_code const& e) noexcept
+                -> type
+            {
+                return { &e.category(), e.value() };
+            }
+
+            static auto format(type const& e, char* out, size_t n)
+                -> size_t
+            {
+                auto message =
+                    e.category->message(static_cast<int>(e.value));
+                return static_cast<size_t>(std::snprintf(
+                    out,
+                    n,
+                    "%s:%lld: %s",
+                    e.category->name(),
+                    static_cast<long long>(e.value),
+                    message.c_str()));
+            }
+        };
+
+        //  Strings are truncated to what fits in a summary.
+        template<>
+        struct error_summary<std::string> {
+            struct type {
+                char text[56];
+            };
+
+            static auto summarize(std::string const& e) noexcept -> type {
+                type t;
+                auto n = std::min(e.size(), sizeof(t.text) - 1);
+                std::memcpy(t.text, e.data(), n);
+                std::memset(t.text + n, 0, sizeof(t.text) - n);
+                return t;
+            }
+
+            static auto format(type const& e, char* out, size_t n)
+                -> size_t
+            {
+                return static_cast<size_t>(
+                    std::snprintf(out, n, "%s", e.text));
+            }
+        };
+    }
+
+    struct ErrorSink {
+
+        static constexpr size_t max_summary = 64;
+
+        using writer_type = std::function<void(char const*, size_t)>;
+
+        struct Options {
+            //  Per logging thread; rounded up to a power of two.
+            size_t buffer_entries = 1024;
+            //  A token bucket: `burst` lines at once, refilled at
+            //  `lines_per_second`.
+            uint32_t lines_per_second = 100;
+            uint32_t burst = 100;
+            std::chrono::milliseconds poll_interval { 10 };
+            //  Receives each formatted line, newline included.
+            //  Defaults to `stderr`.
+            writer_type write;
+        };
+
+        struct Stats {
+            uint64_t logged;
+            uint64_t written;
+            uint64_t repeated;
+            uint64_t suppressed;
+            uint64_t dropped;
+            //  Threads' buffers currently allocated.
+            uint64_t buffers;
+        };
+
+        ErrorSink() :
+            ErrorSink{Options{}}
+        { }
+
+        explicit ErrorSink(Options options) :
+            options_{std::move(options)}
+        ,   id_{next_id()}
+        ,   tokens_{static_cast<double>(options_.burst)}
+        ,   refilled_{std::chrono::steady_clock::now()}
+        {
+            if (!options_.write) {
+                options_.write = [](char const* line, size_t n) {
+                    std::fwrite(line, 1, n, stderr);
+                };
+            }
+
+            size_t capacity = 1;
+            while (capacity < options_.buffer_entries) {
+                capacity <<= 1;
+            }
+            options_.buffer_entries = capacity;
+
+            worker_ = std::thread { [this] { run(); } };
+        }
+
+        ErrorSink(ErrorSink const&) = delete;
+        auto operator=(ErrorSink const&) -> ErrorSink& = delete;
+
+        //  Writes out whatever is still buffered.
+        ~ErrorSink() {
+            {
+                std::lock_guard<std::mutex> lock { wake_mutex_ };
+                stopping_ = true;
+            }
+            wake_.notify_all();
+            worker_.join();
+
+            //  Logging threads drop their references to orphaned
+            //  rings the next time they look for another sink's.
+            std::lock_guard<std::mutex> lock { rings_mutex_ };
+            for (auto& ring : rings_) {
+                ring->orphan();
+            }
+        }
+
+        //  Buffers `error` for the sink's thread. The first call on
+        //  each thread allocates that thread's buffer; after that,
+        //  this only copies the summary. The buffer is freed once the
+        //  thread has exited and the sink has drained it.
+        template<typename E>
+        auto log(char const* site, E const& error) -> void {
+            using Summary = traits::error_summary<E>;
+            using Type = typename Summary::type;
+
+            static_assert(std::is_trivially_copyable<Type>::value,
+                          "error summaries must be trivially copyable");
+            static_assert(sizeof(Type) <= max_summary,
+                          "error summaries must fit in max_summary bytes");
+
+            auto summary = Summary::summarize(error);
+            local_ring().push(&format_summary<Summary>,
+                              site,
+                              &summary,
+                              sizeof(summary));
+        }
+
+        //  Formats and writes everything logged so far, on the
+        //  calling thread, including any pending "repeated" line.
+        auto flush() -> void {
+            drain(true);
+        }
+
+        auto stats() -> Stats {
+            std::lock_guard<std::mutex> lock { drain_mutex_ };
+            auto buffers = uint64_t { 0 };
+            {
+                std::lock_guard<std::mutex> rings_lock { rings_mutex_ };
+                buffers = rings_.size();
+            }
+            return {
+                logged_, written_, repeated_, suppressed_, dropped(), buffers
+            };
+        }
+
+    private:
+        using format_fn = size_t (*)(void const*, char*, size_t);
+
+        struct Entry {
+            format_fn format;
+            char const* site;
+            size_t size;
+            alignas(std::max_align_t) unsigned char summary[max_summary];
+        };
+
+        //  Single producer (the logging thread), single consumer
+        //  (whoever holds `drain_mutex_`).
+        struct Ring {
+            explicit Ring(size_t capacity) :
+                mask_{capacity - 1}
+            ,   entries_{new Entry[capacity]}
+            { }
+
+            auto push(format_fn format,
+                      char const* site,
+                      void const* summary,
+                      size_t size) noexcept -> void
+            {
+                auto head = head_.load(std::memory_order_relaxed);
+                if (head - tail_.load(std::memory_order_acquire) > mask_) {
+                    dropped_.store(
+                        dropped_.load(std::memory_order_relaxed) + 1,
+                        std::memory_order_relaxed);
+                    return;
+                }
+
+                auto& e = entries_[head & mask_];
+                e.format = format;
+                e.site = site;
+                e.size = size;
+                std::memcpy(e.summary, summary, size);
+                head_.store(head + 1, std::memory_order_release);
+            }
+
+            template<typename F>
+            auto drain(F&& f) -> void {
+                auto tail = tail_.load(std::memory_order_relaxed);
+                auto head = head_.load(std::memory_order_acquire);
+                for (; tail != head; ++tail) {
+                    f(entries_[tail & mask_]);
+                }
+                tail_.store(tail, std::memory_order_release);
+            }
+
+            auto dropped() const noexcept -> uint64_t {
+                return dropped_.load(std::memory_order_relaxed);
+            }
+
+            //  Called by the logging thread as it exits; it pushes
+            //  nothing after this.
+            auto retire() noexcept -> void {
+                retired_.store(true, std::memory_order_release);
+            }
+
+            auto retired() const noexcept -> bool {
+                return retired_.load(std::memory_order_acquire);
+            }
+
+            //  Called by the sink as it's destroyed.
+            auto orphan() noexcept -> void {
+                orphaned_.store(true, std::memory_order_relaxed);
+            }
+
+            auto orphaned() const noexcept -> bool {
+                return orphaned_.load(std::memory_order_relaxed);
+            }
+
+        private:
+            size_t mask_;
+            std::unique_ptr<Entry[]> entries_;
+            alignas(64) std::atomic<size_t> head_ { 0 };
+            std::atomic<uint64_t> dropped_ { 0 };
+            alignas(64) std::atomic<size_t> tail_ { 0 };
+            std::atomic<bool> retired_ { false };
+            std::atomic<bool> orphaned_ { false };
+        };
+
+        struct LocalRing {
+            uint64_t sink;
+            std::shared_ptr<Ring> ring;
+        };
+
+        //  A thread's rings, one per sink it has logged to. Each is
+        //  shared with its sink, so neither outlives the ring's use.
+        struct LocalRings {
+            ~LocalRings() {
+                for (auto& r : rings) {
+                    r.ring->retire();
+                }
+            }
+
+            std::vector<LocalRing> rings;
+        };
+
+        static auto next_id() -> uint64_t {
+            static std::atomic<uint64_t> id { 0 };
+            return id.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+
+        template<typename Summary>
+        static auto format_summary(void const* p, char* out, size_t n)
+            -> size_t
+        {
+            typename Summary::type summary;
+            std::memcpy(&summary, p, sizeof(summary));
+            return Summary::format(summary, out, n);
+        }
+
+        //  Sinks are told apart by id rather than address, so a new
+        //  sink at a dead one's address doesn't inherit its buffers.
+        auto local_ring() -> Ring& {
+            static thread_local LocalRings local;
+            auto& rings = local.rings;
+
+            if (!rings.empty() && rings.front().sink == id_) {
+                return *rings.front().ring;
+            }
+
+            rings.erase(std::remove_if(rings.begin(),
+                                       rings.end(),
+                                       [](LocalRing const& r) {
+                                           return r.ring->orphaned();
+                                       }),
+                        rings.end());
+
+            auto it = std::find_if(rings.begin(),
+                                   rings.end(),
+                                   [this](LocalRing const& r) {
+                                       return r.sink == id_;
+                                   });
+            if (it == rings.end()) {
+                auto ring = std::make_shared<Ring>(options_.buffer_entries);
+                {
+                    std::lock_guard<std::mutex> lock { rings_mutex_ };
+                    rings_.push_back(ring);
+                }
+                rings.push_back({ id_, std::move(ring) });
+                it = rings.end() - 1;
+            }
+
+            std::iter_swap(rings.begin(), it);
+            return *rings.front().ring;
+        }
+
+        auto run() -> void {
+            std::unique_lock<std::mutex> lock { wake_mutex_ };
+            while (!stopping_) {
+                wake_.wait_for(lock, options_.poll_interval, [this] {
+                    return stopping_;
+                });
+                lock.unlock();
+                drain(false);
+                lock.lock();
+            }
+            lock.unlock();
+            drain(true);
+        }
+
+        auto drain(bool final) -> void {
+            std::lock_guard<std::mutex> lock { drain_mutex_ };
+
+            //  Formatting and writing happen without `rings_mutex_`,
+            //  which a thread's first `log()` takes.
+            {
+                std::lock_guard<std::mutex> rings_lock { rings_mutex_ };
+                draining_ = rings_;
+            }
+
+            auto retired = false;
+            for (auto& ring : draining_) {
+                //  Checked first, so nothing pushed before retiring is
+                //  missed.
+                if (ring->retired()) {
+                    retired = true;
+                    ring->orphan();
+                }
+                ring->drain([this](Entry const& e) { handle(e); });
+            }
+
+            if (retired) {
+                forget_retired();
+            }
+            draining_.clear();
+
+            auto now = std::chrono::steady_clock::now();
+            if (final || now - last_repeat_report_ >= std::chrono::seconds { 1 }) {
+                report_repeats();
+                last_repeat_report_ = now;
+            }
+
+            auto total_dropped = dropped();
+            if (total_dropped > reported_dropped_) {
+                char line[96];
+                auto n = std::snprintf(
+                    line,
+                    sizeof(line),
+                    "result: dropped %llu errors (buffer full)\n",
+                    static_cast<unsigned long long>(
+                        total_dropped - reported_dropped_));
+                write_line(line, static_cast<size_t>(n));
+                reported_dropped_ = total_dropped;
+            }
+
+            if (final) {
+                report_suppressed();
+            }
+        }
+
+        auto dropped() -> uint64_t {
+            std::lock_guard<std::mutex> lock { rings_mutex_ };
+            auto total = retired_dropped_;
+            for (auto& ring : rings_) {
+                total += ring->dropped();
+            }
+            return total;
+        }
+
+        //  Frees the drained rings of threads that have exited.
+        //  Marking them orphaned (above) identifies them here.
+        auto forget_retired() -> void {
+            std::lock_guard<std::mutex> lock { rings_mutex_ };
+            auto it = std::remove_if(
+                rings_.begin(),
+                rings_.end(),
+                [this](std::shared_ptr<Ring> const& ring) {
+                    if (!ring->orphaned()) {
+                        return false;
+                    }
+                    retired_dropped_ += ring->dropped();
+                    return true;
+                });
+            rings_.erase(it, rings_.end());
+        }
+
+        auto same_as_last(Entry const& e) const noexcept -> bool {
+            return has_last_ &&
+                e.format == last_.format &&
+                e.size == last_.size &&
+                (e.site == last_.site ||
+                    std::strcmp(e.site, last_.site) == 0) &&
+                std::memcmp(e.summary, last_.summary, e.size) == 0;
+        }
+
+        auto handle(Entry const& e) -> void {
+            ++logged_;
+            if (same_as_last(e)) {
+                ++pending_repeats_;
+                ++repeated_;
+                return;
+            }
+
+            report_repeats();
+            last_ = e;
+            has_last_ = true;
+
+            if (!take_token()) {
+                ++pending_suppressed_;
+                ++suppressed_;
+                return;
+            }
+            report_suppressed();
+
+            char line[512];
+            auto prefix = std::snprintf(line, sizeof(line), "%s: ", e.site);
+            auto n = prefix < 0 ? size_t { 0 } : static_cast<size_t>(prefix);
+            n = std::min(n, sizeof(line) - 2);
+            n += e.format(e.summary, line + n, sizeof(line) - 1 - n);
+            n = std::min(n, sizeof(line) - 2);
+            line[n++] = '\n';
+            write_line(line, n);
+        }
+
+        auto report_repeats() -> void {
+            if (!pending_repeats_) {
+                return;
+            }
+
+            char line[256];
+            auto n = std::snprintf(
+                line,
+                sizeof(line),
+                "%s: last error repeated %llu times\n",
+                last_.site,
+                static_cast<unsigned long long>(pending_repeats_));
+            write_line(line, std::min(static_cast<size_t>(n),
+                                      sizeof(line) - 1));
+            pending_repeats_ = 0;
+        }
+
+        auto report_suppressed() -> void {
+            if (!pending_suppressed_) {
+                return;
+            }
+
+            char line[96];
+            auto n = std::snprintf(
+                line,
+                sizeof(line),
+                "result: suppressed %llu errors (rate limit)\n",
+                static_cast<unsigned long long>(pending_suppressed_));
+            write_line(line, static_cast<size_t>(n));
+            pending_suppressed_ = 0;
+        }
+
+        auto take_token() -> bool {
+            auto now = std::chrono::steady_clock::now();
+            std::chrono::duration<double> elapsed = now - refilled_;
+            refilled_ = now;
+            tokens_ = std::min<double>(
+                options_.burst,
+                tokens_ + elapsed.count() * options_.lines_per_second);
+
+            if (tokens_ < 1.0) {
+                return false;
+            }
+            tokens_ -= 1.0;
+            return true;
+        }
+
+        auto write_line(char const* line, size_t n) -> void {
+            ++written_;
+            options_.write(line, n);
+        }
+
+        Options options_;
+        uint64_t id_;
+
+        std::mutex rings_mutex_;
+        std::vector<std::shared_ptr<Ring>> rings_;
+        uint64_t retired_dropped_ = 0;
+
+        //  Everything below is only touched with `drain_mutex_` held.
+        std::mutex drain_mutex_;
+        std::vector<std::shared_ptr<Ring>> draining_;
+        Entry last_;
+        bool has_last_ = false;
+        uint64_t pending_repeats_ = 0;
+        uint64_t pending_suppressed_ = 0;
+        uint64_t reported_dropped_ = 0;
+        double tokens_;
+        std::chrono::steady_clock::time_point refilled_;
+        std::chrono::steady_clock::time_point last_repeat_report_ {};
+        uint64_t logged_ = 0;
+        uint64_t written_ = 0;
+        uint64_t repeated_ = 0;
+        uint64_t suppressed_ = 0;
+
+        std::mutex wake_mutex_;
+        std::condition_variable wake_;
+        bool stopping_ = false;
+        std::thread worker_;
+    };
+
+    namespace detail {
+        struct LogTo {
+            template<typename E>
+            auto operator()(E const& error) const -> void {
+                sink->log(site, error);
+            }
+
+            ErrorSink* sink;
+            char const* site;
+        };
+    }
+
+    //  For `inspect_err`: `r.inspect_err(result::log_to(sink, "db"))`.
+    //  `site` must outlive the sink (a string literal, typically).
+    inline auto log_to(ErrorSink& sink, char const* site = "error")
+        -> detail::LogTo
+    {
+        return { &sink, site };
+    }
+
+    template<typename T, typename E>
+    auto log_err(Result<T, E> const& r,
+                 ErrorSink& sink,
+                 char const* site = "error") -> Result<T, E> const&
+    {
+        return r.inspect_err(log_to(sink, site));
+    }
+
+    template<typename T, typename E>
+    auto log_err(Result<T, E>&& r,
+                 ErrorSink& sink,
+                 char const* site = "error") -> Result<T, E>
+    {
+        return std::move(r).inspect_err(log_to(sink, site));
+    }
+}
+
+#endif //RESULT_LOG_HPP_INCLUDED
@@ -0,0 +1,221 @@
+#ifndef RESULT_MEMO_CACHE_HPP_INCLUDED
+#define RESULT_MEMO_CACHE_HPP_INCLUDED
+
+#include "result/result.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace result {
+
+    //  Memoizes a function returning `Result<T, E>`. Successful
+    //  values are kept until invalidated; errors are kept too
+    //  (*negative caching*) but only for `error_ttl` and/or
+    //  `error_generations`, whichever runs out first. Concurrent
+    //  misses on the same key wait on the first caller's
+    //  computation rather than repeating it.
+    //
+    //  Keys are spread over independently locked shards, and no lock
+    //  is held while the wrapped function runs.
+    template<
+        typename Key,
+        typename T,
+        typename E,
+        typename Hash = std::hash<Key>,
+        typename KeyEqual = std::equal_to<Key>,
+        typename Clock = std::chrono::steady_clock>
+    struct MemoCache {
+
+        using result_type = Result<T, E>;
+        using function_type = std::function<result_type(Key const&)>;
+
+        struct Options {
+            size_t shards = 16;
+            bool cache_errors = true;
+            typename Clock::duration error_ttl =
+                Clock::duration::max();
+            uint64_t error_generations =
+                std::numeric_limits<uint64_t>::max();
+        };
+
+        struct Stats {
+            uint64_t hits;
+            uint64_t misses;
+            uint64_t coalesced;
+        };
+
+        explicit MemoCache(function_type f) :
+            MemoCache{std::move(f), Options{}}
+        { }
+
+        MemoCache(function_type f, Options options) :
+            f_{std::move(f)}
+        ,   options_{options}
+        ,   shards_{new Shard[options.shards ? options.shards : 1]}
+        {
+            if (!options_.shards) {
+                options_.shards = 1;
+            }
+        }
+
+        MemoCache(MemoCache const&) = delete;
+        auto operator=(MemoCache const&) -> MemoCache& = delete;
+
+        auto get(Key const& key) -> result_type {
+            auto& shard = shard_for(key);
+            std::unique_lock<std::mutex> lock { shard.mutex };
+
+            auto it = shard.entries.find(key);
+            if (it != shard.entries.end() && is_fresh(it->second)) {
+                auto value = it->second.value;
+                if (it->second.pending) {
+                    coalesced_.fetch_add(1, std::memory_order_relaxed);
+                }
+                else {
+                    hits_.fetch_add(1, std::memory_order_relaxed);
+                }
+                lock.unlock();
+                return value.get();
+            }
+
+            misses_.fetch_add(1, std::memory_order_relaxed);
+
+            std::promise<result_type> promise;
+            Entry entry;
+            entry.value = promise.get_future().share();
+            if (it != shard.entries.end()) {
+                it->second = entry;
+            }
+            else {
+                it = shard.entries.emplace(key, entry).first;
+            }
+            auto const id = ++shard.next_id;
+            it->second.id = id;
+            lock.unlock();
+
+            try {
+                promise.set_value(f_(key));
+            }
+            catch (...) {
+                promise.set_exception(std::current_exception());
+                lock.lock();
+                erase_if_current(shard, key, id);
+                throw;
+            }
+
+            auto const& r = entry.value.get();
+
+            lock.lock();
+            auto current = shard.entries.find(key);
+            if (current == shard.entries.end() ||
+                current->second.id != id)
+            {
+                return r;
+            }
+
+            if (!r.is_ok() && !options_.cache_errors) {
+                shard.entries.erase(current);
+                return r;
+            }
+
+            current->second.pending = false;
+            current->second.is_error = !r.is_ok();
+            current->second.stored_at = Clock::now();
+            current->second.generation =
+                generation_.load(std::memory_order_relaxed);
+            return r;
+        }
+
+        //  Forgets `key`, successful or not. Callers already waiting
+        //  on a computation for `key` still receive its result.
+        auto invalidate(Key const& key) -> void {
+            auto& shard = shard_for(key);
+            std::lock_guard<std::mutex> lock { shard.mutex };
+            shard.entries.erase(key);
+        }
+
+        auto clear() -> void {
+            for (size_t i = 0; i < options_.shards; ++i) {
+                std::lock_guard<std::mutex> lock { shards_[i].mutex };
+                shards_[i].entries.clear();
+            }
+        }
+
+        //  Ages every cached error by one generation.
+        auto next_generation() noexcept -> void {
+            generation_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        auto stats() const noexcept -> Stats {
+            return Stats {
+                hits_.load(std::memory_order_relaxed),
+                misses_.load(std::memory_order_relaxed),
+                coalesced_.load(std::memory_order_relaxed)
+            };
+        }
+
+    private:
+        struct Entry {
+            std::shared_future<result_type> value;
+            typename Clock::time_point stored_at {};
+            uint64_t generation = 0;
+            uint64_t id = 0;
+            bool pending = true;
+            bool is_error = false;
+        };
+
+        struct Shard {
+            std::mutex mutex;
+            std::unordered_map<Key, Entry, Hash, KeyEqual> entries;
+            uint64_t next_id = 0;
+        };
+
+        auto shard_for(Key const& key) -> Shard& {
+            auto h = static_cast<uint64_t>(Hash{}(key));
+            //  `std::hash` is the identity for integers on some
+            //  implementations, so mix before reducing.
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdull;
+            h ^= h >> 33;
+            return shards_[h % options_.shards];
+        }
+
+        auto is_fresh(Entry const& entry) const -> bool {
+            if (entry.pending || !entry.is_error) {
+                return true;
+            }
+
+            auto age = generation_.load(std::memory_order_relaxed) -
+                entry.generation;
+            return age < options_.error_generations &&
+                Clock::now() - entry.stored_at < options_.error_ttl;
+        }
+
+        static auto erase_if_current(Shard& shard,
+                                     Key const& key,
+                                     uint64_t id) -> void
+        {
+            auto it = shard.entries.find(key);
+            if (it != shard.entries.end() && it->second.id == id) {
+                shard.entries.erase(it);
+            }
+        }
+
+        function_type f_;
+        Options options_;
+        std::unique_ptr<Shard[]> shards_;
+        std::atomic<uint64_t> generation_ { 0 };
+        std::atomic<uint64_t> hits_ { 0 };
+        std::atomic<uint64_t> misses_ { 0 };
+        std::atomic<uint64_t> coalesced_ { 0 };
+    };
+}
+
+#endif //RESULT_MEMO_CACHE_HPP_INCLUDED
@@ -0,0 +1,657 @@
+#ifndef RESULT_ONE_OF_HPP_INCLUDED
+#define RESULT_ONE_OF_HPP_INCLUDED
+
+#include "result/result.hpp"
+#include "result/traits.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+//  A closed set of error types, e.g.
+//
+//      using ReadError = result::OneOf<std::error_code, ParseError>;
+//
+//      auto read_config() -> result::Result<Config, ReadError> {
+//          auto text = read_file(path);        // Result<..., std::error_code>
+//          if (!text) {
+//              return result::err(std::move(text).error());
+//          }
+//          return parse(text.value());         // Result<Config, ParseError>
+//      }
+//
+//  Any `Result<T, Ei>` converts to `Result<T, OneOf<..., Ei, ...>>`,
+//  as does a `Result` over a smaller `OneOf`. Inside a `Result`, the
+//  `OneOf`'s discriminant doubles as the `Result`'s own, so there is
+//  only one tag to store and test.
+namespace result {
+
+    namespace detail {
+
+        template<typename E, typename... Es>
+        struct index_of;
+
+        template<typename E>
+        struct index_of<E> : std::integral_constant<size_t, 0>
+        { };
+
+        template<typename E, typename... Es>
+        struct index_of<E, E, Es...> : std::integral_constant<size_t, 0>
+        { };
+
+        template<typename E, typename F, typename... Es>
+        struct index_of<E, F, Es...> :
+            std::integral_constant<size_t, 1 + index_of<E, Es...>::value>
+        { };
+
+        template<bool... Bs>
+        struct all_of : std::true_type
+        { };
+
+        template<bool B, bool... Bs>
+        struct all_of<B, Bs...> :
+            std::integral_constant<bool, B && all_of<Bs...>::value>
+        { };
+
+        template<size_t... Ns>
+        struct max_of : std::integral_constant<size_t, 1>
+        { };
+
+        template<size_t N, size_t... Ns>
+        struct max_of<N, Ns...> :
+            std::integral_constant<
+                size_t,
+                (N > max_of<Ns...>::value) ? N : max_of<Ns...>::value>
+        { };
+
+        //  The discriminant values a `Result` uses for its own states
+        //  when its error is a `OneOf`. Alternatives are numbered from
+        //  zero.
+        constexpr uint8_t one_of_value_tag = 0xfe;
+        constexpr uint8_t one_of_empty_tag = 0xff;
+
+        template<typename... Es>
+        using all_nothrow_movable =
+            all_of<std::is_nothrow_move_constructible<Es>::value...>;
+
+        template<typename T, typename... Es>
+        struct OneOfStorage;
+    }
+
+    template<typename... Es>
+    struct OneOf {
+
+        static_assert(sizeof...(Es) > 0 &&
+                          sizeof...(Es) < detail::one_of_value_tag,
+                      "OneOf needs between 1 and 253 alternatives");
+
+        template<
+            typename U,
+            typename D = typename std::decay<U>::type,
+            typename
+                std::enable_if<
+                    detail::index_of<D, Es...>::value <
+                        sizeof...(Es)>::type* = nullptr
+        >
+        OneOf(U&& error) :
+            index_{static_cast<uint8_t>(detail::index_of<D, Es...>::value)}
+        {
+            new (&storage_) D{std::forward<U>(error)};
+        }
+
+        //  Widens a `OneOf` over a subset of these alternatives.
+        template<
+            typename... Fs,
+            typename
+                std::enable_if<
+                    !std::is_same<OneOf<Fs...>, OneOf>::value &&
+                        detail::all_of<
+                            (detail::index_of<Fs, Es...>::value <
+                                sizeof...(Es))...>::value>::type* = nullptr
+        >
+        OneOf(OneOf<Fs...>&& other) :
+            index_{0}
+        {
+            std::move(other).visit([this](auto&& e) {
+                using D = typename std::decay<decltype(e)>::type;
+                new (&storage_) D{std::move(e)};
+                index_ = static_cast<uint8_t>(
+                    detail::index_of<D, Es...>::value);
+            });
+        }
+
+        template<
+            typename... Fs,
+            typename
+                std::enable_if<
+                    !std::is_same<OneOf<Fs...>, OneOf>::value &&
+                        detail::all_of<
+                            (detail::index_of<Fs, Es...>::value <
+                                sizeof...(Es))...>::value>::type* = nullptr
+        >
+        OneOf(OneOf<Fs...> const& other) :
+            index_{0}
+        {
+            other.visit([this](auto const& e) {
+                using D = typename std::decay<decltype(e)>::type;
+                new (&storage_) D{e};
+                index_ = static_cast<uint8_t>(
+                    detail::index_of<D, Es...>::value);
+            });
+        }
+
+        OneOf(OneOf&& other)
+            noexcept(detail::all_nothrow_movable<Es...>::value) :
+            index_{other.index_}
+        {
+            std::move(other).visit([this](auto&& e) {
+                using D = typename std::decay<decltype(e)>::type;
+                new (&storage_) D{std::move(e)};
+            });
+        }
+
+        OneOf(OneOf const& other) :
+            index_{other.index_}
+        {
+            other.visit([this](auto const& e) {
+                using D = typename std::decay<decltype(e)>::type;
+                new (&storage_) D{e};
+            });
+        }
+
+        //  If an alternative's move constructor throws, the `OneOf`
+        //  is left valueless and may only be destroyed or assigned
+        //  to. In a `Result`, that's the `Result`'s empty state.
+        auto operator=(OneOf&& other)
+            noexcept(detail::all_nothrow_movable<Es...>::value) -> OneOf&
+        {
+            if (this != &other) {
+                destroy();
+                move_from(std::move(other));
+            }
+            return *this;
+        }
+
+        //  The copy is made before anything is destroyed, so a
+        //  throwing copy constructor leaves `*this` as it was.
+        auto operator=(OneOf const& other) -> OneOf& {
+            if (this != &other) {
+                OneOf copy { other };
+                destroy();
+                move_from(std::move(copy));
+            }
+            return *this;
+        }
+
+        ~OneOf() {
+            destroy();
+        }
+
+        //  The position of the held alternative in `Es...`.
+        auto index() const noexcept -> size_t { return index_; }
+
+        template<typename E>
+        auto holds() const noexcept -> bool {
+            return index_ == detail::index_of<E, Es...>::value;
+        }
+
+        template<typename E>
+        auto get_if() noexcept -> E* {
+            return holds<E>() ? reinterpret_cast<E*>(&storage_) : nullptr;
+        }
+
+        template<typename E>
+        auto get_if() const noexcept -> E const* {
+            return const_cast<OneOf&>(*this).template get_if<E>();
+        }
+
+        template<typename E>
+        auto get() & -> E& {
+            if (!holds<E>()) {
+                throw BadResultAccess {
+                    "The error holds a different alternative" };
+            }
+            return *reinterpret_cast<E*>(&storage_);
+        }
+
+        template<typename E>
+        auto get() const& -> E const& {
+            return const_cast<OneOf&>(*this).template get<E>();
+        }
+
+        template<typename E>
+        auto get() && -> E&& {
+            return std::move(get<E>());
+        }
+
+        //  Calls `f` with the held alternative. Every alternative
+        //  must be accepted; the results must have a common type.
+        template<typename F>
+        decltype(auto) visit(F&& f) & {
+            return visit_at<0, result_t<F, Es&...>>(*this, f);
+        }
+
+        template<typename F>
+        decltype(auto) visit(F&& f) const& {
+            return visit_at<0, result_t<F, Es const&...>>(*this, f);
+        }
+
+        template<typename F>
+        decltype(auto) visit(F&& f) && {
+            return visit_at<0, result_t<F, Es&&...>>(std::move(*this), f);
+        }
+
+        friend auto operator==(OneOf const& lhs, OneOf const& rhs) -> bool {
+            return lhs.index_ == rhs.index_ &&
+                lhs.visit([&rhs](auto const& e) {
+                    using D = typename std::decay<decltype(e)>::type;
+                    return e == *rhs.template get_if<D>();
+                });
+        }
+
+        friend auto operator!=(OneOf const& lhs, OneOf const& rhs) -> bool {
+            return !(lhs == rhs);
+        }
+
+    private:
+        template<typename... Fs>
+        friend struct OneOf;
+
+        template<typename T, typename... Fs>
+        friend struct detail::OneOfStorage;
+
+        template<typename F, typename... As>
+        using result_t = typename std::common_type<
+            typename std::result_of<F&(As)>::type...>::type;
+
+        template<size_t I>
+        using alternative_t =
+            typename std::tuple_element<I, std::tuple<Es...>>::type;
+
+        template<size_t I, typename R, typename Self, typename F>
+        static auto visit_at(Self&& self, F& f)
+            -> typename std::enable_if<(I + 1 < sizeof...(Es)), R>::type
+        {
+            if (self.index_ == I) {
+                return visit_one<I, R>(std::forward<Self>(self), f);
+            }
+            return visit_at<I + 1, R>(std::forward<Self>(self), f);
+        }
+
+        template<size_t I, typename R, typename Self, typename F>
+        static auto visit_at(Self&& self, F& f)
+            -> typename std::enable_if<(I + 1 == sizeof...(Es)), R>::type
+        {
+            return visit_one<I, R>(std::forward<Self>(self), f);
+        }
+
+        template<size_t I, typename R, typename Self, typename F>
+        static auto visit_one(Self&& self, F& f) -> R {
+            using A = alternative_t<I>;
+            using P = typename std::conditional<
+                std::is_const<
+                    typename std::remove_reference<Self>::type>::value,
+                A const*,
+                A*>::type;
+            using Ref = typename std::conditional<
+                std::is_lvalue_reference<Self>::value,
+                decltype(*std::declval<P>()),
+                A&&>::type;
+            return f(static_cast<Ref>(
+                *reinterpret_cast<P>(&self.storage_)));
+        }
+
+        auto destroy() noexcept -> void {
+            if (index_ == detail::one_of_empty_tag) {
+                return;
+            }
+            visit([](auto& e) {
+                using D = typename std::decay<decltype(e)>::type;
+                e.~D();
+            });
+            index_ = detail::one_of_empty_tag;
+        }
+
+        //  Only valid on a destroyed `OneOf`.
+        auto move_from(OneOf&& other) -> void {
+            std::move(other).visit([this](auto&& e) {
+                using D = typename std::decay<decltype(e)>::type;
+                new (&storage_) D{std::move(e)};
+            });
+            index_ = other.index_;
+        }
+
+        //  Must stay the first member; see `detail::OneOfStorage`.
+        uint8_t index_;
+        typename std::aligned_storage<
+            detail::max_of<sizeof(Es)...>::value,
+            detail::max_of<alignof(Es)...>::value>::type storage_;
+    };
+
+    template<typename F, typename... Es>
+    decltype(auto) visit(F&& f, OneOf<Es...>& e) {
+        return e.visit(std::forward<F>(f));
+    }
+
+    template<typename F, typename... Es>
+    decltype(auto) visit(F&& f, OneOf<Es...> const& e) {
+        return e.visit(std::forward<F>(f));
+    }
+
+    template<typename F, typename... Es>
+    decltype(auto) visit(F&& f, OneOf<Es...>&& e) {
+        return std::move(e).visit(std::forward<F>(f));
+    }
+
+    namespace traits {
+
+        template<typename... Es>
+        struct is_trivially_relocatable<OneOf<Es...>> :
+            detail::all_of<is_trivially_relocatable<Es>::value...>
+        { };
+    }
+
+    namespace detail {
+
+        //  `Storage` for a `Result<T, OneOf<Es...>>`. The value, the
+        //  error and the empty state are kept in standard-layout
+        //  structs that all start with a `uint8_t`, so that byte can
+        //  be read through any of them (their *common initial
+        //  sequence*). For the error, it's the `OneOf`'s own
+        //  discriminant; the value and empty states use numbers no
+        //  alternative can have. The value is kept in raw storage,
+        //  so its slot stays standard-layout whatever `T` is.
+        template<typename T, typename... Es>
+        struct OneOfStorage {
+
+            using Error = OneOf<Es...>;
+
+            enum class UnionTag {
+                Empty,
+                Value,
+                Error
+            };
+
+            OneOfStorage() noexcept :
+                storage_{}
+            { }
+
+            template<typename U>
+            OneOfStorage(Ok<U> ok) :
+                storage_{std::move(ok.get()), ValueGuide{}}
+            { }
+
+            template<typename U>
+            OneOfStorage(Err<U> err) :
+                storage_{std::move(err.get()), ErrorGuide{}}
+            { }
+
+            template<typename A, typename U>
+            OneOfStorage(std::allocator_arg_t, A const& alloc, Ok<U> ok) :
+                storage_{}
+            {
+                allocator_emplace_value(alloc, std::move(ok.get()));
+            }
+
+            template<typename A, typename U>
+            OneOfStorage(std::allocator_arg_t, A const&, Err<U> err) :
+                storage_{}
+            {
+                emplace_error(std::move(err.get()));
+            }
+
+            template<typename A>
+            OneOfStorage(std::allocator_arg_t,
+                         A const& alloc,
+                         OneOfStorage&& other) :
+                storage_{}
+            {
+                if (other.tag() == UnionTag::Value) {
+                    allocator_emplace_value(
+                        alloc, std::move(other.stored_value()));
+                }
+                else {
+                    construct_from(std::move(other));
+                }
+            }
+
+            template<typename A>
+            OneOfStorage(std::allocator_arg_t,
+                         A const& alloc,
+                         OneOfStorage const& other) :
+                storage_{}
+            {
+                if (other.tag() == UnionTag::Value) {
+                    allocator_emplace_value(alloc, other.stored_value());
+                }
+                else {
+                    construct_from(other);
+                }
+            }
+
+            OneOfStorage(OneOfStorage&& other)
+                noexcept(std::is_nothrow_move_constructible<T>::value &&
+                         all_nothrow_movable<Es...>::value) :
+                storage_{}
+            {
+                construct_from(std::move(other));
+            }
+
+            OneOfStorage(OneOfStorage const& other) :
+                storage_{}
+            {
+                construct_from(other);
+            }
+
+            auto operator=(OneOfStorage&& other)
+                noexcept(std::is_nothrow_move_constructible<T>::value &&
+                         all_nothrow_movable<Es...>::value) -> OneOfStorage&
+            {
+                if (this != &other) {
+                    destroy();
+                    construct_from(std::move(other));
+                }
+                return *this;
+            }
+
+            auto operator=(OneOfStorage const& other) -> OneOfStorage& {
+                if (this != &other) {
+                    destroy();
+                    construct_from(other);
+                }
+                return *this;
+            }
+
+            ~OneOfStorage() {
+                destroy();
+            }
+
+            auto tag() const noexcept -> UnionTag {
+                switch (storage_.empty.tag) {
+                    case one_of_empty_tag:
+                        return UnionTag::Empty;
+                    case one_of_value_tag:
+                        return UnionTag::Value;
+                    default:
+                        return UnionTag::Error;
+                }
+            }
+
+            auto stored_value() noexcept -> T& {
+                return storage_.value.get();
+            }
+
+            auto stored_value() const noexcept -> T const& {
+                return const_cast<OneOfStorage&>(*this).stored_value();
+            }
+
+            auto stored_error() noexcept -> Error& {
+                return storage_.error;
+            }
+
+            auto stored_error() const noexcept -> Error const& {
+                return storage_.error;
+            }
+
+            //  Only valid on an empty `OneOfStorage`, which stays empty
+            //  if the constructor throws.
+            template<typename U>
+            auto emplace_value(U&& value) -> void {
+                try {
+                    new (&storage_.value) ValueSlot{std::forward<U>(value)};
+                }
+                catch (...) {
+                    new (&storage_.empty) EmptySlot{one_of_empty_tag};
+                    throw;
+                }
+            }
+
+            template<typename U>
+            auto emplace_error(U&& error) -> void {
+                try {
+                    new (&storage_.error) Error{std::forward<U>(error)};
+                }
+                catch (...) {
+                    new (&storage_.empty) EmptySlot{one_of_empty_tag};
+                    throw;
+                }
+            }
+
+        private:
+            struct ValueGuide { };
+            struct ErrorGuide { };
+
+            struct EmptySlot {
+                uint8_t tag;
+            };
+
+            struct ValueSlot {
+                template<typename U>
+                explicit ValueSlot(U&& v) :
+                    tag{one_of_value_tag}
+                {
+                    new (&value) T{std::forward<U>(v)};
+                }
+
+                template<typename A, typename U>
+                ValueSlot(std::allocator_arg_t, A const& alloc, U&& v) :
+                    tag{one_of_value_tag}
+                {
+                    construct_with_allocator(&get(),
+                                             alloc,
+                                             std::forward<U>(v));
+                }
+
+                auto get() noexcept -> T& {
+                    return *reinterpret_cast<T*>(&value);
+                }
+
+                uint8_t tag;
+                typename std::aligned_storage<sizeof(T), alignof(T)>::type
+                    value;
+            };
+
+            static_assert(std::is_standard_layout<EmptySlot>::value &&
+                              std::is_standard_layout<ValueSlot>::value &&
+                              std::is_standard_layout<Error>::value,
+                          "the tag is read through the common initial "
+                          "sequence of these");
+
+            union Union {
+                EmptySlot empty;
+                ValueSlot value;
+                Error error;
+
+                Union() noexcept :
+                    empty{one_of_empty_tag}
+                { }
+
+                template<typename U>
+                Union(U&& v, ValueGuide) :
+                    value{std::forward<U>(v)}
+                { }
+
+                template<typename U>
+                Union(U&& e, ErrorGuide) :
+                    error{std::forward<U>(e)}
+                { }
+
+                ~Union() { }
+            };
+
+            template<typename A, typename U>
+            auto allocator_emplace_value(A const& alloc, U&& value)
+                -> void
+            {
+                new (&storage_.value) ValueSlot{
+                    std::allocator_arg, alloc, std::forward<U>(value)};
+            }
+
+            static auto value_of(OneOfStorage&& other) noexcept -> T&& {
+                return std::move(other.stored_value());
+            }
+
+            static auto value_of(OneOfStorage const& other) noexcept
+                -> T const&
+            {
+                return other.stored_value();
+            }
+
+            //  `Other` is `OneOfStorage&&` or `OneOfStorage const&`.
+            //  Leaves `*this` empty if a constructor throws.
+            template<typename Other>
+            auto construct_from(Other&& other) -> void {
+                switch (other.tag()) {
+                    case UnionTag::Empty:
+                        break;
+                    case UnionTag::Value:
+                        emplace_value(
+                            value_of(std::forward<Other>(other)));
+                        break;
+                    case UnionTag::Error:
+                        emplace_error(
+                            std::forward<Other>(other).storage_.error);
+                        break;
+                }
+            }
+
+            auto destroy() noexcept -> void {
+                switch (tag()) {
+                    case UnionTag::Empty:
+                        break;
+                    case UnionTag::Value:
+                        storage_.value.get().~T();
+                        break;
+                    case UnionTag::Error:
+                        storage_.error.~Error();
+                        break;
+                }
+                new (&storage_.empty) EmptySlot{one_of_empty_tag};
+            }
+
+            Union storage_;
+        };
+
+        template<typename T, typename... Es>
+        struct Storage<T, OneOf<Es...>, true> : OneOfStorage<T, Es...> {
+            using OneOfStorage<T, Es...>::OneOfStorage;
+        };
+
+        template<typename T, typename... Es>
+        struct Storage<T, OneOf<Es...>, false> : OneOfStorage<T, Es...> {
+
+            using Base = OneOfStorage<T, Es...>;
+            using Base::Base;
+
+            Storage() = default;
+            Storage(Storage&&) = default;
+            Storage(Storage const&) = delete;
+            auto operator=(Storage&&) -> Storage& = default;
+            auto operator=(Storage const&) -> Storage& = delete;
+        };
+    }
+}
+
+#endif //RESULT_ONE_OF_HPP_INCLUDED
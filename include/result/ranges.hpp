@@ -0,0 +1,701 @@
+#ifndef RESULT_RANGES_HPP_INCLUDED
+#define RESULT_RANGES_HPP_INCLUDED
+
+#include "result/result.hpp"
+#include "result/traits.hpp"
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__has_include)
+#if __has_include(<version>)
+#include <version>
+#endif
+#endif
+
+#if defined(__cpp_lib_ranges)
+#include <ranges>
+#endif
+
+//  Lazy, non-allocating adaptors over sequences of `Result<T, E>`.
+//  Every adaptor can be used in three ways...
+//
+//      result::filter_ok(first, last)
+//      result::filter_ok(records)
+//      records | result::filter_ok()
+//
+//  Adaptors only hold iterators (or, when chained, the adapted view
+//  by value) plus any callable, so nothing is materialized; each
+//  element is inspected as the resulting range is walked. A
+//  temporary container is moved into the adaptor, rather than
+//  referred to, so it lives as long as the adaptor does.
+namespace result {
+
+    namespace detail {
+
+        template<typename It>
+        using iter_reference_t = decltype(*std::declval<It&>());
+
+        template<typename It>
+        using iter_result_t =
+            typename std::decay<iter_reference_t<It>>::type;
+
+        template<typename Range>
+        using range_iterator_t =
+            decltype(std::begin(std::declval<Range&>()));
+
+        //  Yields what `Ref.value()` / `Ref.error()` give us,
+        //  unless `Ref` is a prvalue (e.g. the element of a
+        //  `transform_ok` range) in which case we have to yield
+        //  by value, otherwise we'd hand out a dangling reference.
+        template<typename Ref>
+        using ok_reference_t =
+            typename std::conditional<
+                std::is_reference<Ref>::value,
+                decltype(std::declval<Ref>().value()),
+                typename std::decay<
+                    decltype(std::declval<Ref>().value())>::type
+            >::type;
+
+        template<typename Ref>
+        using err_reference_t =
+            typename std::conditional<
+                std::is_reference<Ref>::value,
+                decltype(std::declval<Ref>().error()),
+                typename std::decay<
+                    decltype(std::declval<Ref>().error())>::type
+            >::type;
+
+        template<typename It>
+        using base_category_t =
+            typename std::iterator_traits<It>::iterator_category;
+
+        //  We never go backwards, so the best we can offer is
+        //  forward iteration, and only when the element is a
+        //  real reference.
+        template<typename It, typename Ref>
+        using adapted_category_t =
+            typename std::conditional<
+                std::is_reference<Ref>::value &&
+                    std::is_base_of<
+                        std::forward_iterator_tag,
+                        base_category_t<It>>::value,
+                std::forward_iterator_tag,
+                std::input_iterator_tag
+            >::type;
+
+        struct ViewBase
+#if defined(__cpp_lib_ranges)
+            : std::ranges::view_base
+#endif
+        { };
+
+        template<typename It>
+        struct IteratorRange : ViewBase {
+
+            IteratorRange() = default;
+
+            IteratorRange(It first, It last) :
+                first_{std::move(first)}
+            ,   last_{std::move(last)}
+            { }
+
+            auto begin() const -> It { return first_; }
+            auto end() const -> It { return last_; }
+
+        private:
+            It first_;
+            It last_;
+        };
+
+        //  Takes ownership of a temporary container so that the
+        //  iterators we hand out don't outlive it.
+        template<typename Range>
+        struct OwningRange : ViewBase {
+
+            OwningRange() = default;
+
+            explicit OwningRange(Range range) :
+                range_{std::move(range)}
+            { }
+
+            auto begin() const -> range_iterator_t<Range const> {
+                return std::begin(range_);
+            }
+
+            auto end() const -> range_iterator_t<Range const> {
+                return std::end(range_);
+            }
+
+        private:
+            Range range_;
+        };
+
+        template<typename Range>
+        struct is_view : std::is_base_of<ViewBase, Range>
+        { };
+
+        //  Chained views are held by value, as are temporary
+        //  containers. Anything else (i.e. a named container) is
+        //  only referred to by its iterators and must outlive the
+        //  adaptor.
+        template<
+            typename Range,
+            typename std::enable_if<
+                is_view<typename std::decay<Range>::type>::value
+            >::type* = nullptr
+        >
+        auto all(Range&& r) -> typename std::decay<Range>::type {
+            return std::forward<Range>(r);
+        }
+
+        template<
+            typename Range,
+            typename std::enable_if<
+                !is_view<typename std::decay<Range>::type>::value &&
+                    std::is_lvalue_reference<Range>::value
+            >::type* = nullptr
+        >
+        auto all(Range&& r) -> IteratorRange<range_iterator_t<Range>> {
+            return { std::begin(r), std::end(r) };
+        }
+
+        template<
+            typename Range,
+            typename std::enable_if<
+                !is_view<typename std::decay<Range>::type>::value &&
+                    !std::is_lvalue_reference<Range>::value
+            >::type* = nullptr
+        >
+        auto all(Range&& r)
+            -> OwningRange<typename std::decay<Range>::type>
+        {
+            return OwningRange<typename std::decay<Range>::type> {
+                std::forward<Range>(r) };
+        }
+
+        template<typename Range>
+        using all_t = decltype(all(std::declval<Range>()));
+
+        //  Holds the element a `SelectIterator` is positioned on.
+        //  When the underlying iterator yields a reference there's
+        //  nothing to hold and each access goes straight through it.
+        template<
+            typename It,
+            typename Ref = iter_reference_t<It>,
+            bool = std::is_reference<Ref>::value
+        >
+        struct ElementCache {
+            auto peek(It const& it) const -> Ref { return *it; }
+            auto read(It const& it) const -> Ref { return *it; }
+            auto reset() -> void { }
+        };
+
+        //  ...otherwise dereferencing computes the element (e.g. it
+        //  runs the callable of a `transform_ok`), so it's done once
+        //  per position and the result is kept until we move on. A
+        //  copyable element is copied out on each read; a move-only
+        //  one is moved out, and a second read computes it again.
+        template<typename It, typename Ref>
+        struct ElementCache<It, Ref, false> {
+
+            using element_type = typename std::remove_cv<Ref>::type;
+            using copyable =
+                std::is_copy_constructible<element_type>;
+            using read_type =
+                typename std::conditional<
+                    copyable::value,
+                    element_type const&,
+                    element_type
+                >::type;
+
+            ElementCache() = default;
+
+            ElementCache(ElementCache const& other) {
+                copy_from(other, copyable{});
+            }
+
+            ElementCache(ElementCache&& other) {
+                if (other.engaged_) {
+                    emplace(std::move(other.get()));
+                }
+            }
+
+            ~ElementCache() {
+                reset();
+            }
+
+            auto operator=(ElementCache const& other) -> ElementCache& {
+                if (this != &other) {
+                    reset();
+                    copy_from(other, copyable{});
+                }
+                return *this;
+            }
+
+            auto operator=(ElementCache&& other) -> ElementCache& {
+                if (this != &other) {
+                    reset();
+                    if (other.engaged_) {
+                        emplace(std::move(other.get()));
+                    }
+                }
+                return *this;
+            }
+
+            auto peek(It const& it) const -> element_type const& {
+                return load(it);
+            }
+
+            auto read(It const& it) const -> read_type {
+                return take(it, copyable{});
+            }
+
+            auto reset() const -> void {
+                if (engaged_) {
+                    engaged_ = false;
+                    get().~element_type();
+                }
+            }
+
+        private:
+            auto load(It const& it) const -> element_type& {
+                if (!engaged_) {
+                    emplace(*it);
+                }
+                return get();
+            }
+
+            auto take(It const& it, std::true_type) const -> read_type {
+                return load(it);
+            }
+
+            auto take(It const& it, std::false_type) const -> read_type {
+                element_type element { std::move(load(it)) };
+                reset();
+                return element;
+            }
+
+            auto copy_from(ElementCache const& other, std::true_type)
+                -> void
+            {
+                if (other.engaged_) {
+                    emplace(other.get());
+                }
+            }
+
+            //  A move-only element can't be copied, so the copy
+            //  computes its own when it's first read.
+            auto copy_from(ElementCache const&, std::false_type) -> void
+            { }
+
+            template<typename U>
+            auto emplace(U&& element) const -> void {
+                new (static_cast<void*>(&storage_))
+                    element_type(std::forward<U>(element));
+                engaged_ = true;
+            }
+
+            auto get() const noexcept -> element_type& {
+                return *reinterpret_cast<element_type*>(&storage_);
+            }
+
+            mutable typename std::aligned_storage<
+                sizeof(element_type),
+                alignof(element_type)
+            >::type storage_;
+            mutable bool engaged_ = false;
+        };
+
+        //  Holds the shared state for the single-pass adaptors
+        //  that skip or stop on elements; `Pred` decides whether
+        //  an element is yielded, `StopOnMiss` whether the first
+        //  rejected element ends the range.
+        template<typename It, typename Pred, bool StopOnMiss>
+        struct SelectIterator {
+
+            using reference = typename Pred::template reference<It>;
+            using value_type = typename std::decay<reference>::type;
+            using difference_type =
+                typename std::iterator_traits<It>::difference_type;
+            using pointer =
+                typename std::add_pointer<reference>::type;
+            using iterator_category =
+                adapted_category_t<It, iter_reference_t<It>>;
+
+            SelectIterator() = default;
+
+            SelectIterator(It current, It last) :
+                current_{std::move(current)}
+            ,   last_{std::move(last)}
+            {
+                settle();
+            }
+
+            auto operator*() const -> reference {
+                return Pred::get(cache_.read(current_));
+            }
+
+            auto operator++() -> SelectIterator& {
+                cache_.reset();
+                ++current_;
+                settle();
+                return *this;
+            }
+
+            auto operator++(int) -> SelectIterator {
+                auto tmp = *this;
+                ++*this;
+                return tmp;
+            }
+
+            friend auto operator==(SelectIterator const& lhs,
+                                   SelectIterator const& rhs)
+                -> bool
+            {
+                return lhs.current_ == rhs.current_;
+            }
+
+            friend auto operator!=(SelectIterator const& lhs,
+                                   SelectIterator const& rhs)
+                -> bool
+            {
+                return !(lhs == rhs);
+            }
+
+        private:
+            auto settle() -> void {
+                if (StopOnMiss) {
+                    if (current_ != last_ &&
+                        !Pred::test(cache_.peek(current_)))
+                    {
+                        cache_.reset();
+                        current_ = last_;
+                    }
+                    return;
+                }
+
+                while (current_ != last_ &&
+                       !Pred::test(cache_.peek(current_)))
+                {
+                    cache_.reset();
+                    ++current_;
+                }
+            }
+
+            It current_;
+            It last_;
+            ElementCache<It> cache_;
+        };
+
+        struct SelectOk {
+            template<typename It>
+            using reference = ok_reference_t<iter_reference_t<It>>;
+
+            template<typename R>
+            static auto test(R const& r) -> bool { return r.is_ok(); }
+
+            template<typename R>
+            static auto get(R&& r) -> ok_reference_t<R> {
+                return std::forward<R>(r).value();
+            }
+        };
+
+        struct SelectErr {
+            template<typename It>
+            using reference = err_reference_t<iter_reference_t<It>>;
+
+            template<typename R>
+            static auto test(R const& r) -> bool { return !r.is_ok(); }
+
+            template<typename R>
+            static auto get(R&& r) -> err_reference_t<R> {
+                return std::forward<R>(r).error();
+            }
+        };
+
+        template<typename Base, typename Pred, bool StopOnMiss>
+        struct SelectView : ViewBase {
+
+            using base_iterator = range_iterator_t<Base const>;
+            using iterator =
+                SelectIterator<base_iterator, Pred, StopOnMiss>;
+
+            SelectView() = default;
+
+            explicit SelectView(Base base) :
+                base_{std::move(base)}
+            { }
+
+            auto begin() const -> iterator {
+                return { std::begin(base_), std::end(base_) };
+            }
+
+            auto end() const -> iterator {
+                return { std::end(base_), std::end(base_) };
+            }
+
+        private:
+            Base base_;
+        };
+
+        //  Applies `Op` to each element and yields the resulting
+        //  `Result` by value. `Op` knows how to combine the
+        //  element with the user's callable (i.e. `map` or
+        //  `and_then` semantics).
+        template<typename It, typename F, typename Op>
+        struct ApplyIterator {
+
+            using reference =
+                typename Op::template result_type<iter_reference_t<It>, F>;
+            using value_type = reference;
+            using difference_type =
+                typename std::iterator_traits<It>::difference_type;
+            using pointer = void;
+            using iterator_category = std::input_iterator_tag;
+
+            ApplyIterator() = default;
+
+            ApplyIterator(It current, F const* f) :
+                current_{std::move(current)}
+            ,   f_{f}
+            { }
+
+            auto operator*() const -> reference {
+                return Op::apply(*current_, *f_);
+            }
+
+            auto operator++() -> ApplyIterator& {
+                ++current_;
+                return *this;
+            }
+
+            auto operator++(int) -> ApplyIterator {
+                auto tmp = *this;
+                ++*this;
+                return tmp;
+            }
+
+            friend auto operator==(ApplyIterator const& lhs,
+                                   ApplyIterator const& rhs)
+                -> bool
+            {
+                return lhs.current_ == rhs.current_;
+            }
+
+            friend auto operator!=(ApplyIterator const& lhs,
+                                   ApplyIterator const& rhs)
+                -> bool
+            {
+                return !(lhs == rhs);
+            }
+
+        private:
+            It current_;
+            F const* f_ = nullptr;
+        };
+
+        struct MapOk {
+            template<typename Ref, typename F>
+            using result_type =
+                Result<
+                    typename std::decay<
+                        typename std::result_of<
+                            F const&(ok_reference_t<Ref>)>::type
+                    >::type,
+                    typename std::decay<err_reference_t<Ref>>::type>;
+
+            template<typename R, typename F>
+            static auto apply(R&& r, F const& f)
+                -> result_type<R, F>
+            {
+                if (r.is_ok()) {
+                    return result::ok(f(std::forward<R>(r).value()));
+                }
+                return result::err(std::forward<R>(r).error());
+            }
+        };
+
+        struct AndThenOk {
+            template<typename Ref, typename F>
+            using result_type =
+                Result<
+                    typename traits::result_traits<
+                        typename std::decay<
+                            typename std::result_of<
+                                F const&(ok_reference_t<Ref>)>::type
+                        >::type
+                    >::value_type,
+                    typename std::decay<err_reference_t<Ref>>::type>;
+
+            template<typename R, typename F>
+            static auto apply(R&& r, F const& f)
+                -> result_type<R, F>
+            {
+                if (r.is_ok()) {
+                    return f(std::forward<R>(r).value());
+                }
+                return result::err(std::forward<R>(r).error());
+            }
+        };
+
+        template<typename Base, typename F, typename Op>
+        struct ApplyView : ViewBase {
+
+            using base_iterator = range_iterator_t<Base const>;
+            using iterator = ApplyIterator<base_iterator, F, Op>;
+
+            ApplyView(Base base, F f) :
+                base_{std::move(base)}
+            ,   f_{std::move(f)}
+            { }
+
+            auto begin() const -> iterator {
+                return { std::begin(base_), &f_ };
+            }
+
+            auto end() const -> iterator {
+                return { std::end(base_), &f_ };
+            }
+
+        private:
+            Base base_;
+            F f_;
+        };
+
+        template<typename Pred, bool StopOnMiss>
+        struct SelectAdaptor {
+            template<typename Range>
+            friend auto operator|(Range&& r, SelectAdaptor)
+                -> SelectView<all_t<Range>, Pred, StopOnMiss>
+            {
+                return SelectView<all_t<Range>, Pred, StopOnMiss> {
+                    all(std::forward<Range>(r)) };
+            }
+        };
+
+        template<typename F, typename Op>
+        struct ApplyAdaptor {
+            explicit ApplyAdaptor(F f) :
+                f_{std::move(f)}
+            { }
+
+            template<typename Range>
+            friend auto operator|(Range&& r, ApplyAdaptor a)
+                -> ApplyView<all_t<Range>, F, Op>
+            {
+                return { all(std::forward<Range>(r)), std::move(a.f_) };
+            }
+
+        private:
+            F f_;
+        };
+
+        using FilterOkAdaptor = SelectAdaptor<SelectOk, false>;
+        using TakeWhileOkAdaptor = SelectAdaptor<SelectOk, true>;
+        using ErrorsOnlyAdaptor = SelectAdaptor<SelectErr, false>;
+    }
+
+    template<typename It>
+    auto make_range(It first, It last) -> detail::IteratorRange<It> {
+        return { std::move(first), std::move(last) };
+    }
+
+    //  Yields the value of each successful element, skipping errors.
+    inline auto filter_ok() -> detail::FilterOkAdaptor {
+        return {};
+    }
+
+    template<typename Range>
+    auto filter_ok(Range&& r) {
+        return std::forward<Range>(r) | filter_ok();
+    }
+
+    template<typename It>
+    auto filter_ok(It first, It last) {
+        return make_range(std::move(first), std::move(last)) | filter_ok();
+    }
+
+    //  Yields the value of each element up to, but not including,
+    //  the first error.
+    inline auto take_while_ok() -> detail::TakeWhileOkAdaptor {
+        return {};
+    }
+
+    template<typename Range>
+    auto take_while_ok(Range&& r) {
+        return std::forward<Range>(r) | take_while_ok();
+    }
+
+    template<typename It>
+    auto take_while_ok(It first, It last) {
+        return make_range(std::move(first), std::move(last))
+            | take_while_ok();
+    }
+
+    //  Yields the error of each failed element, skipping successes.
+    inline auto errors_only() -> detail::ErrorsOnlyAdaptor {
+        return {};
+    }
+
+    template<typename Range>
+    auto errors_only(Range&& r) {
+        return std::forward<Range>(r) | errors_only();
+    }
+
+    template<typename It>
+    auto errors_only(It first, It last) {
+        return make_range(std::move(first), std::move(last))
+            | errors_only();
+    }
+
+    //  Yields `Result<U, E>` for each element, where successful
+    //  values have been passed through `f`. Errors are passed on
+    //  untouched.
+    template<typename F>
+    auto transform_ok(F&& f)
+        -> detail::ApplyAdaptor<typename std::decay<F>::type,
+                                detail::MapOk>
+    {
+        return detail::ApplyAdaptor<typename std::decay<F>::type,
+                                    detail::MapOk> {
+            std::forward<F>(f) };
+    }
+
+    template<typename Range, typename F>
+    auto transform_ok(Range&& r, F&& f) {
+        return std::forward<Range>(r) | transform_ok(std::forward<F>(f));
+    }
+
+    template<typename It, typename F>
+    auto transform_ok(It first, It last, F&& f) {
+        return make_range(std::move(first), std::move(last))
+            | transform_ok(std::forward<F>(f));
+    }
+
+    //  As `transform_ok`, but `f` returns a result itself, in the
+    //  same way as `Result::and_then`.
+    template<typename F>
+    auto and_then_each(F&& f)
+        -> detail::ApplyAdaptor<typename std::decay<F>::type,
+                                detail::AndThenOk>
+    {
+        return detail::ApplyAdaptor<typename std::decay<F>::type,
+                                    detail::AndThenOk> {
+            std::forward<F>(f) };
+    }
+
+    template<typename Range, typename F>
+    auto and_then_each(Range&& r, F&& f) {
+        return std::forward<Range>(r) | and_then_each(std::forward<F>(f));
+    }
+
+    template<typename It, typename F>
+    auto and_then_each(It first, It last, F&& f) {
+        return make_range(std::move(first), std::move(last))
+            | and_then_each(std::forward<F>(f));
+    }
+}
+
+#endif //RESULT_RANGES_HPP_INCLUDED
@@ -0,0 +1,319 @@
+#ifndef RESULT_RELOCATE_HPP_INCLUDED
+#define RESULT_RELOCATE_HPP_INCLUDED
+
+#include "result/traits.hpp"
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace result {
+
+    namespace detail {
+        template<typename T>
+        auto relocate_n(T* first, size_t n, T* dest, std::true_type)
+            noexcept -> T*
+        {
+            if (n) {
+                std::memmove(static_cast<void*>(dest),
+                             static_cast<void const*>(first),
+                             n * sizeof(T));
+            }
+            return dest + n;
+        }
+
+        //  Nothing can throw, so each object can be moved and
+        //  destroyed in turn.
+        template<typename T>
+        auto move_and_destroy_n(T* first, size_t n, T* dest, std::true_type)
+            noexcept -> T*
+        {
+            for (size_t i = 0; i < n; ++i) {
+                new (static_cast<void*>(dest + i)) T{std::move(first[i])};
+                first[i].~T();
+            }
+            return dest + n;
+        }
+
+        //  The objects are copied, and a copy may throw; the
+        //  originals are only destroyed once they've all been copied.
+        template<typename T>
+        auto move_and_destroy_n(T* first, size_t n, T* dest, std::false_type)
+            -> T*
+        {
+            size_t i = 0;
+            try {
+                for (; i < n; ++i) {
+                    new (static_cast<void*>(dest + i)) T{
+                        std::move_if_noexcept(first[i])};
+                }
+            }
+            catch (...) {
+                while (i) {
+                    dest[--i].~T();
+                }
+                throw;
+            }
+
+            for (i = 0; i < n; ++i) {
+                first[i].~T();
+            }
+            return dest + n;
+        }
+
+        template<typename T>
+        auto relocate_n(T* first, size_t n, T* dest, std::false_type)
+            -> T*
+        {
+            return move_and_destroy_n(
+                first,
+                n,
+                dest,
+                std::integral_constant<
+                    bool,
+                    std::is_nothrow_move_constructible<T>::value>{});
+        }
+    }
+
+    //  Moves `n` objects from `[first, first + n)` into the
+    //  uninitialized storage at `dest`, ending the lifetime of
+    //  the originals. The ranges may only overlap if `dest`
+    //  precedes `first`. Returns `dest + n`.
+    //
+    //  A `T` that's neither trivially relocatable nor nothrow
+    //  movable is copied instead. If a copy throws, the copies made
+    //  so far are destroyed and the originals are left in place
+    //  (unchanged, unless `T` can only be moved); for such types the
+    //  ranges mustn't overlap at all.
+    template<typename T>
+    auto relocate_n(T* first, size_t n, T* dest) -> T* {
+        return detail::relocate_n(
+            first,
+            n,
+            dest,
+            std::integral_constant<
+                bool,
+                traits::is_trivially_relocatable<T>::value>{});
+    }
+
+    //  A minimal, contiguous vector that grows and erases with
+    //  `relocate_n`, so for trivially relocatable element types
+    //  (e.g. `Result<std::unique_ptr<X>, std::error_code>`) it's
+    //  a single `memcpy`/`memmove` rather than a move and
+    //  destroy per element.
+    template<typename T, typename Allocator = std::allocator<T>>
+    struct RelocatingVector {
+
+        using value_type = T;
+        using size_type = size_t;
+        using iterator = T*;
+        using const_iterator = T const*;
+        using allocator_type = Allocator;
+
+        RelocatingVector() = default;
+
+        explicit RelocatingVector(Allocator const& alloc) :
+            alloc_{alloc}
+        { }
+
+        RelocatingVector(RelocatingVector&& other) noexcept :
+            alloc_{std::move(other.alloc_)}
+        ,   data_{other.data_}
+        ,   size_{other.size_}
+        ,   capacity_{other.capacity_}
+        {
+            other.data_ = nullptr;
+            other.size_ = 0;
+            other.capacity_ = 0;
+        }
+
+        RelocatingVector(RelocatingVector const&) = delete;
+
+        auto operator=(RelocatingVector&& other) noexcept
+            -> RelocatingVector&
+        {
+            if (this != &other) {
+                release();
+                alloc_ = std::move(other.alloc_);
+                data_ = other.data_;
+                size_ = other.size_;
+                capacity_ = other.capacity_;
+                other.data_ = nullptr;
+                other.size_ = 0;
+                other.capacity_ = 0;
+            }
+            return *this;
+        }
+
+        auto operator=(RelocatingVector const&)
+            -> RelocatingVector& = delete;
+
+        ~RelocatingVector() {
+            release();
+        }
+
+        auto size() const noexcept -> size_t { return size_; }
+        auto capacity() const noexcept -> size_t { return capacity_; }
+        auto empty() const noexcept -> bool { return size_ == 0; }
+
+        auto data() noexcept -> T* { return data_; }
+        auto data() const noexcept -> T const* { return data_; }
+
+        auto begin() noexcept -> iterator { return data_; }
+        auto end() noexcept -> iterator { return data_ + size_; }
+        auto begin() const noexcept -> const_iterator { return data_; }
+        auto end() const noexcept -> const_iterator {
+            return data_ + size_;
+        }
+
+        auto operator[](size_t n) noexcept -> T& { return data_[n]; }
+        auto operator[](size_t n) const noexcept -> T const& {
+            return data_[n];
+        }
+
+        auto back() noexcept -> T& { return data_[size_ - 1]; }
+
+        auto reserve(size_t n) -> void {
+            if (n <= capacity_) {
+                return;
+            }
+
+            auto new_data = AllocTraits::allocate(alloc_, n);
+            try {
+                relocate_n(data_, size_, new_data);
+            }
+            catch (...) {
+                AllocTraits::deallocate(alloc_, new_data, n);
+                throw;
+            }
+            if (data_) {
+                AllocTraits::deallocate(alloc_, data_, capacity_);
+            }
+            data_ = new_data;
+            capacity_ = n;
+        }
+
+        template<typename... Args>
+        auto emplace_back(Args&&... args) -> T& {
+            if (size_ == capacity_) {
+                grow_and_emplace(std::forward<Args>(args)...);
+            }
+            else {
+                new (static_cast<void*>(data_ + size_)) T{
+                    std::forward<Args>(args)...};
+            }
+            return data_[size_++];
+        }
+
+        auto push_back(T&& item) -> void {
+            emplace_back(std::move(item));
+        }
+
+        auto push_back(T const& item) -> void {
+            emplace_back(item);
+        }
+
+        auto pop_back() noexcept -> void {
+            data_[--size_].~T();
+        }
+
+        auto erase(const_iterator pos) -> iterator {
+            auto p = data_ + (pos - data_);
+            p->~T();
+            close_gap(
+                p,
+                std::integral_constant<
+                    bool,
+                    traits::is_trivially_relocatable<T>::value ||
+                        std::is_nothrow_move_constructible<T>::value>{});
+            --size_;
+            return p;
+        }
+
+        auto clear() noexcept -> void {
+            for (size_t i = 0; i < size_; ++i) {
+                data_[i].~T();
+            }
+            size_ = 0;
+        }
+
+    private:
+        using AllocTraits = std::allocator_traits<Allocator>;
+
+        //  The new element is constructed before the existing ones
+        //  are relocated, as `args` may refer into the old buffer.
+        template<typename... Args>
+        auto grow_and_emplace(Args&&... args) -> void {
+            auto new_capacity = capacity_ ? capacity_ * 2 : 4;
+            auto new_data = AllocTraits::allocate(alloc_, new_capacity);
+            try {
+                new (static_cast<void*>(new_data + size_)) T{
+                    std::forward<Args>(args)...};
+            }
+            catch (...) {
+                AllocTraits::deallocate(alloc_, new_data, new_capacity);
+                throw;
+            }
+
+            try {
+                relocate_n(data_, size_, new_data);
+            }
+            catch (...) {
+                new_data[size_].~T();
+                AllocTraits::deallocate(alloc_, new_data, new_capacity);
+                throw;
+            }
+            if (data_) {
+                AllocTraits::deallocate(alloc_, data_, capacity_);
+            }
+            data_ = new_data;
+            capacity_ = new_capacity;
+        }
+
+        //  Shifts everything after the destroyed element at `p` down
+        //  by one.
+        auto close_gap(T* p, std::true_type) noexcept -> void {
+            relocate_n(p + 1, static_cast<size_t>(end() - (p + 1)), p);
+        }
+
+        //  The ranges overlap, so the elements are copied one at a
+        //  time. If a copy throws, that element and the ones after it
+        //  are destroyed and dropped, leaving a shorter but valid
+        //  vector.
+        auto close_gap(T* p, std::false_type) -> void {
+            auto last = end();
+            for (auto q = p + 1; q != last; ++q) {
+                try {
+                    new (static_cast<void*>(q - 1)) T{
+                        std::move_if_noexcept(*q)};
+                }
+                catch (...) {
+                    for (auto r = q; r != last; ++r) {
+                        r->~T();
+                    }
+                    size_ = static_cast<size_t>((q - 1) - data_);
+                    throw;
+                }
+                q->~T();
+            }
+        }
+
+        auto release() noexcept -> void {
+            clear();
+            if (data_) {
+                AllocTraits::deallocate(alloc_, data_, capacity_);
+            }
+            data_ = nullptr;
+            capacity_ = 0;
+        }
+
+        Allocator alloc_ {};
+        T* data_ = nullptr;
+        size_t size_ = 0;
+        size_t capacity_ = 0;
+    };
+}
+
+#endif //RESULT_RELOCATE_HPP_INCLUDED
@@ -0,0 +1,144 @@
+//  A C++20 module interface for the library; configure with
+//  `-DRESULT_BUILD_MODULE=ON` and link `Result::module`, then
+//
+//      import result;
+//
+//  The headers are parsed once, when this unit is built, instead of
+//  in every translation unit that includes them. Macros (e.g.
+//  `RESULT_ENABLE_FAULT_INJECTION`) aren't exported; they take
+//  effect through the flags this unit is compiled with.
+module;
+
+#include "result/boxed.hpp"
+#include "result/fault.hpp"
+#include "result/lazy.hpp"
+#include "result/log.hpp"
+#include "result/memo_cache.hpp"
+#include "result/one_of.hpp"
+#include "result/ranges.hpp"
+#include "result/relocate.hpp"
+#include "result/result.hpp"
+#include "result/retry.hpp"
+#include "result/thread_pool.hpp"
+#include "result/traits.hpp"
+#include "result/validate.hpp"
+#include "result/when.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include "result/io.hpp"
+#include "result/io_ring.hpp"
+#endif
+
+export module result;
+
+export namespace result {
+
+    //  result/result.hpp
+    using result::Result;
+    using result::BadResultAccess;
+    using result::ok;
+    using result::err;
+    using result::value;
+    using result::error;
+    using result::value_or_else;
+    using result::map;
+    using result::map_err;
+    using result::and_then;
+    using result::or_else;
+    using result::inspect_err;
+    using result::flatten;
+    using result::join;
+
+    //  result/one_of.hpp
+    using result::OneOf;
+    using result::visit;
+
+    //  result/boxed.hpp
+    using result::Boxed;
+    using result::CompactResult;
+
+    //  result/ranges.hpp
+    using result::make_range;
+    using result::filter_ok;
+    using result::take_while_ok;
+    using result::errors_only;
+    using result::transform_ok;
+    using result::and_then_each;
+
+    //  result/relocate.hpp
+    using result::relocate_n;
+    using result::RelocatingVector;
+
+    //  result/validate.hpp
+    using result::ErrorList;
+    using result::Validated;
+    using result::validate;
+
+    //  result/memo_cache.hpp
+    using result::MemoCache;
+
+    //  result/thread_pool.hpp, result/retry.hpp and result/when.hpp
+    using result::ThreadPool;
+    using result::WorkStealingPool;
+    using result::SteadyTimer;
+    using result::RetryPolicy;
+    using result::retry_policy;
+    using result::retry;
+    using result::hedge;
+    using result::CancellationToken;
+    using result::CancellationSource;
+    using result::when_all;
+    using result::when_any;
+
+    //  result/lazy.hpp
+    using result::LazyErrorPolicy;
+    using result::LazyResult;
+
+    //  result/log.hpp
+    using result::ErrorSink;
+    using result::log_to;
+    using result::log_err;
+
+    //  result/fault.hpp
+    using result::inject;
+
+    namespace fault {
+        using result::fault::Registry;
+    }
+
+    namespace traits {
+        using result::traits::is_result;
+        using result::traits::is_convertible_to_result;
+        using result::traits::result_traits;
+        using result::traits::inner_result_value_traits;
+        using result::traits::inner_result_error_traits;
+        using result::traits::is_trivially_relocatable;
+        using result::traits::is_one_of;
+        using result::traits::should_box_error;
+        using result::traits::error_summary;
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+    namespace io {
+        using result::io::IoResult;
+        using result::io::FileDescriptor;
+        using result::io::open;
+        using result::io::read;
+        using result::io::pread;
+        using result::io::readv;
+        using result::io::write;
+        using result::io::writev;
+        using result::io::read_all;
+        using result::io::pread_all;
+        using result::io::write_all;
+        using result::io::fstat;
+        using result::io::mmap;
+        using result::io::munmap;
+        using result::io::ByteView;
+        using result::io::MappedFile;
+        using result::io::ReadRequest;
+        using result::io::IoRingBackend;
+        using result::io::IoRing;
+    }
+#endif
+}
@@ -2,8 +2,11 @@
 #define RESULT_RESULT_HPP_INCLUDED
 
 #include "result/traits.hpp"
+#include <memory>
+#include <new>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
 
 namespace result {
 
@@ -30,6 +33,56 @@ namespace result {
 
         struct VoidType { };
 
+        //  *Uses-allocator construction* (see [allocator.uses]) of a
+        //  `T` at `p`; `alloc` is passed on if `T` accepts one,
+        //  either as a leading `std::allocator_arg_t, alloc` pair or
+        //  as a trailing argument, and otherwise ignored.
+        template<
+            typename T,
+            typename A,
+            typename... Args,
+            typename std::enable_if<
+                !std::uses_allocator<T, A>::value
+            >::type* = nullptr>
+        auto construct_with_allocator(T* p, A const&, Args&&... args)
+            -> void
+        {
+            new (p) T{std::forward<Args>(args)...};
+        }
+
+        template<
+            typename T,
+            typename A,
+            typename... Args,
+            typename std::enable_if<
+                std::uses_allocator<T, A>::value &&
+                std::is_constructible<
+                    T, std::allocator_arg_t, A const&, Args...>::value
+            >::type* = nullptr>
+        auto construct_with_allocator(T* p, A const& alloc, Args&&... args)
+            -> void
+        {
+            new (p) T(std::allocator_arg, alloc, std::forward<Args>(args)...);
+        }
+
+        template<
+            typename T,
+            typename A,
+            typename... Args,
+            typename std::enable_if<
+                std::uses_allocator<T, A>::value &&
+                !std::is_constructible<
+                    T, std::allocator_arg_t, A const&, Args...>::value
+            >::type* = nullptr>
+        auto construct_with_allocator(T* p, A const& alloc, Args&&... args)
+            -> void
+        {
+            static_assert(
+                std::is_constructible<T, Args..., A const&>::value,
+                "`T` uses the allocator but can't be constructed with it");
+            new (p) T(std::forward<Args>(args)..., alloc);
+        }
+
         template<
             typename T, 
             typename E,
@@ -57,6 +110,50 @@ namespace result {
             ,   tag_{UnionTag::Error}
             { }
 
+            template<typename A, typename U>
+            Storage(std::allocator_arg_t, A const& alloc, Ok<U> ok) :
+                storage_{}
+            ,   tag_{UnionTag::Empty}
+            {
+                storage_.destroy(tag_);
+                construct_with_allocator(&storage_.value,
+                                         alloc,
+                                         std::move(ok.get()));
+                tag_ = UnionTag::Value;
+            }
+
+            template<typename A, typename U>
+            Storage(std::allocator_arg_t, A const& alloc, Err<U> err) :
+                storage_{}
+            ,   tag_{UnionTag::Empty}
+            {
+                storage_.destroy(tag_);
+                construct_with_allocator(&storage_.error,
+                                         alloc,
+                                         std::move(err.get()));
+                tag_ = UnionTag::Error;
+            }
+
+            template<typename A>
+            Storage(std::allocator_arg_t, A const& alloc, Storage&& other) :
+                storage_{}
+            ,   tag_{UnionTag::Empty}
+            {
+                storage_.destroy(tag_);
+                allocator_construct(*this, alloc, std::move(other));
+            }
+
+            template<typename A>
+            Storage(std::allocator_arg_t,
+                    A const& alloc,
+                    Storage const& other) :
+                storage_{}
+            ,   tag_{UnionTag::Empty}
+            {
+                storage_.destroy(tag_);
+                allocator_construct(*this, alloc, other);
+            }
+
             Storage(Storage&& other)
                 noexcept(
                     noexcept(T{std::declval<T>()}) &&
@@ -107,9 +204,6 @@ namespace result {
 
             static auto move_construct(Storage& _this,
                                        Storage&& other)
-                noexcept(
-                    noexcept(T{std::declval<T>()}) &&
-                    noexcept(E{std::declval<E>()}))
             {
                 try {
                     Union::move_construct(_this.storage_, 
@@ -125,9 +219,6 @@ namespace result {
 
             static auto copy_construct(Storage& _this,
                                        Storage const& other)
-                noexcept(
-                    noexcept(T{std::declval<T const&>()}) &&
-                    noexcept(E{std::declval<E const&>()}))
             {
                 try {
                     Union::copy_construct(_this.storage_, 
@@ -141,6 +232,33 @@ namespace result {
                 }
             }
 
+            //  `Other` is either `Storage&&` or `Storage const&`, so
+            //  the alternative is moved or copied accordingly.
+            template<typename A, typename Other>
+            static auto allocator_construct(Storage& _this,
+                                            A const& alloc,
+                                            Other&& other)
+            {
+                switch (other.tag_) {
+                    case UnionTag::Empty:
+                        new (&_this.storage_.empty) Default{};
+                        break;
+                    case UnionTag::Value:
+                        construct_with_allocator(
+                            &_this.storage_.value,
+                            alloc,
+                            std::forward<Other>(other).storage_.value);
+                        break;
+                    case UnionTag::Error:
+                        construct_with_allocator(
+                            &_this.storage_.error,
+                            alloc,
+                            std::forward<Other>(other).storage_.error);
+                        break;
+                }
+                _this.tag_ = other.tag_;
+            }
+
             struct Default { };
             struct ValueGuide { };
             struct ErrorGuide { };
@@ -232,6 +350,36 @@ namespace result {
                 }
             };
 
+            //  `Result` only goes through these (and the constructors)
+            //  so that other storage layouts can be swapped in by
+            //  specializing `Storage`; see `result/one_of.hpp`.
+            auto tag() const noexcept -> UnionTag { return tag_; }
+
+            auto stored_value() noexcept -> T& { return storage_.value; }
+            auto stored_value() const noexcept -> T const& {
+                return storage_.value;
+            }
+
+            auto stored_error() noexcept -> E& { return storage_.error; }
+            auto stored_error() const noexcept -> E const& {
+                return storage_.error;
+            }
+
+            //  Only valid on an empty `Storage`.
+            template<typename U>
+            auto emplace_value(U&& value) -> void {
+                storage_.destroy(tag_);
+                new (&storage_.value) T{std::forward<U>(value)};
+                tag_ = UnionTag::Value;
+            }
+
+            template<typename U>
+            auto emplace_error(U&& error) -> void {
+                storage_.destroy(tag_);
+                new (&storage_.error) E{std::forward<U>(error)};
+                tag_ = UnionTag::Error;
+            }
+
             Union storage_;
             UnionTag tag_;
         };
@@ -241,6 +389,8 @@ namespace result {
 
             using Base = Storage<T, E, true>;
 
+            Storage() = default;
+
             template<typename U>
             Storage(Ok<U> ok)
                 noexcept(noexcept(Base{std::declval<Ok<U>>()})) :
@@ -253,6 +403,21 @@ namespace result {
                 Base{std::move(err)}
             { }
 
+            template<typename A, typename U>
+            Storage(std::allocator_arg_t, A const& alloc, Ok<U> ok) :
+                Base{std::allocator_arg, alloc, std::move(ok)}
+            { }
+
+            template<typename A, typename U>
+            Storage(std::allocator_arg_t, A const& alloc, Err<U> err) :
+                Base{std::allocator_arg, alloc, std::move(err)}
+            { }
+
+            template<typename A>
+            Storage(std::allocator_arg_t, A const& alloc, Storage&& other) :
+                Base{std::allocator_arg, alloc, static_cast<Base&&>(other)}
+            { }
+
             Storage(Storage&&) = default;
             Storage(Storage const&) = delete;
             auto operator=(Storage&&) -> Storage& = default;
@@ -285,12 +450,101 @@ namespace result {
         { }
     };
 
+    namespace detail {
+
+        //  How a `Result<T, E>` hands out its stored `E` through
+        //  `error()`: as is, except for wrappers such as `Boxed<E>`
+        //  (see `result/boxed.hpp`), which are seen through.
+        template<typename E>
+        struct ErrorAccess {
+            using type = E;
+
+            static auto get(E& e) noexcept -> E& { return e; }
+        };
+
+        //  Selects `Result`'s error-widening constructor.
+        struct Widen { };
+
+        template<typename F, typename E>
+        struct widens_error :
+            std::integral_constant<
+                bool,
+                !std::is_same<F, E>::value &&
+                    std::is_convertible<F, E>::value>
+        { };
+
+        //  Helpers for `flatten()` and `join()`. They walk down a
+        //  nested `Result` by reference and only move the innermost
+        //  value (or error) once, into the `Out` being returned.
+        template<typename Out, typename T, typename E>
+        auto move_value_into(Result<T, E>& r) -> Out {
+            return Out { Ok<T&&> { std::move(r.value()) } };
+        }
+
+        template<typename Out, typename E>
+        auto move_value_into(Result<void, E>&) -> Out {
+            return Out { result::ok() };
+        }
+
+        template<typename Out, typename T, typename E>
+        auto move_error_into(Result<T, E>& r) -> Out {
+            return Out { Err<E&&> { std::move(r.error()) } };
+        }
+
+        template<typename Out, typename T, typename E>
+        auto flatten_into(Result<T, E>& r, std::false_type) -> Out {
+            if (r.is_ok()) {
+                return move_value_into<Out>(r);
+            }
+            return move_error_into<Out>(r);
+        }
+
+        template<typename Out, typename T, typename E>
+        auto flatten_into(Result<T, E>& r, std::true_type) -> Out {
+            if (r.is_ok()) {
+                return flatten_into<Out>(
+                    r.value(),
+                    typename traits::result_traits<T>::value_is_result{});
+            }
+            return move_error_into<Out>(r);
+        }
+
+        template<typename Out, typename T, typename E>
+        auto join_into(Result<T, E>& r, std::false_type) -> Out {
+            if (r.is_ok()) {
+                return move_value_into<Out>(r);
+            }
+            return move_error_into<Out>(r);
+        }
+
+        template<typename Out, typename T, typename E>
+        auto join_into(Result<T, E>& r, std::true_type) -> Out {
+            if (r.is_ok()) {
+                return move_value_into<Out>(r);
+            }
+            return join_into<Out>(
+                r.error(),
+                typename traits::result_traits<E>::error_is_result{});
+        }
+
+        template<typename R>
+        using flattened_t = Result<
+            typename traits::inner_result_value_traits<R>::value_type,
+            typename traits::result_traits<R>::error_type>;
+
+        template<typename R>
+        using joined_t = Result<
+            typename traits::result_traits<R>::value_type,
+            typename traits::inner_result_error_traits<R>::error_type>;
+    }
+
     template<typename T, typename E>
     struct Result : 
         private detail::Storage<T, E> 
     {
 
         using Base = detail::Storage<T, E>;
+        using ErrorType = typename detail::ErrorAccess<E>::type;
 
         template<typename U>
         Result(detail::Ok<U> ok) 
@@ -304,18 +558,80 @@ namespace result {
             Base{std::move(err)}
         { }
 
+        //  Allocator-extended constructors. The stored value or
+        //  error is built by uses-allocator construction, so e.g.
+        //  `std::pmr` containers end up in `alloc`'s resource rather
+        //  than the default one.
+        template<typename A, typename U>
+        Result(std::allocator_arg_t, A const& alloc, detail::Ok<U> ok) :
+            Base{std::allocator_arg, alloc, std::move(ok)}
+        { }
+
+        template<typename A, typename U>
+        Result(std::allocator_arg_t, A const& alloc, detail::Err<U> err) :
+            Base{std::allocator_arg, alloc, std::move(err)}
+        { }
+
+        template<typename A>
+        Result(std::allocator_arg_t, A const& alloc, Result&& other) :
+            Base{std::allocator_arg, alloc, static_cast<Base&&>(other)}
+        { }
+
+        template<typename A>
+        Result(std::allocator_arg_t, A const& alloc, Result const& other) :
+            Base{std::allocator_arg, alloc, static_cast<Base const&>(other)}
+        { }
+
+        //  Widens the error type, e.g. from `Result<T, E1>` to
+        //  `Result<T, OneOf<E1, E2>>`. That's implicit, so errors
+        //  propagate into a `OneOf` without ceremony; converting to
+        //  any other error type has to be asked for.
+        template<
+            typename F,
+            typename 
+                std::enable_if<
+                    detail::widens_error<F, E>::value &&
+                        traits::is_one_of<E>::value>::type* = nullptr
+        >
+        Result(Result<T, F>&& other) :
+            Result{detail::Widen{}, std::move(other)}
+        { }
+
+        template<
+            typename F,
+            typename 
+                std::enable_if<
+                    detail::widens_error<F, E>::value &&
+                        !traits::is_one_of<E>::value>::type* = nullptr
+        >
+        explicit Result(Result<T, F>&& other) :
+            Result{detail::Widen{}, std::move(other)}
+        { }
+
+        template<typename F>
+        Result(detail::Widen, Result<T, F>&& other) :
+            Base{}
+        {
+            if (other.is_ok()) {
+                Base::emplace_value(std::move(other).value());
+            }
+            else {
+                Base::emplace_error(std::move(other).error());
+            }
+        }
+
         Result() = delete;
 
         friend auto operator==(Result const& lhs,
                                Result const& rhs) noexcept 
             -> bool
         {
-            return (lhs.tag_ == rhs.tag_) &&
-                (lhs.tag_ == Base::UnionTag::Empty ||
-                    (lhs.tag_ == Base::UnionTag::Value && 
-                        lhs.storage_.value == rhs.storage_.value) ||
-                    (lhs.tag_ == Base::UnionTag::Error &&
-                        lhs.storage_.error == rhs.storage_.error));
+            return (lhs.tag() == rhs.tag()) &&
+                (lhs.tag() == Base::UnionTag::Empty ||
+                    (lhs.tag() == Base::UnionTag::Value && 
+                        lhs.stored_value() == rhs.stored_value()) ||
+                    (lhs.tag() == Base::UnionTag::Error &&
+                        lhs.stored_error() == rhs.stored_error()));
         }
 
         friend auto operator!=(Result const& lhs,
@@ -326,7 +642,7 @@ namespace result {
         }
 
         auto is_ok() const noexcept -> bool {
-            return Base::tag_ == Base::UnionTag::Value;
+            return Base::tag() == Base::UnionTag::Value;
         }
 
         operator bool() const {
@@ -334,11 +650,11 @@ namespace result {
         }
 
         auto value() & -> T& {
-            if (Base::tag_ != Base::UnionTag::Value) {
+            if (Base::tag() != Base::UnionTag::Value) {
                 throw BadResultAccess { "The result contains an error" };
             }
 
-            return Base::storage_.value;
+            return Base::stored_value();
         }
 
         auto value() const& -> const T& {
@@ -349,19 +665,19 @@ namespace result {
             return std::move(value());
         }
 
-        auto error() & -> E& {
-            if (Base::tag_ != Base::UnionTag::Error) {
+        auto error() & -> ErrorType& {
+            if (Base::tag() != Base::UnionTag::Error) {
                 throw BadResultAccess { "The result doesn't contain an error" };
             }
 
-            return Base::storage_.error;
+            return detail::ErrorAccess<E>::get(Base::stored_error());
         }
 
-        auto error() const& -> const E& {
+        auto error() const& -> const ErrorType& {
             return const_cast<Result&>(*this).error();
         }
 
-        auto error() && -> E&& {
+        auto error() && -> ErrorType&& {
             return std::move(error());
         }
 
@@ -373,12 +689,31 @@ namespace result {
                 return result::ok(
                     std::forward<F>(f)(std::move(*this).value()));
             }
-            return result::err(std::move(*this).error());
+            return result::err(std::move(Base::stored_error()));
+        }
+
+        //  As `map`, but the new `Result` is constructed with
+        //  `alloc` (see the allocator-extended constructors).
+        template<typename A, typename F>
+        auto map(std::allocator_arg_t, A const& alloc, F&& f) &&
+            -> Result<typename std::result_of<F(T&&)>::type, E>
+        {
+            if (is_ok()) {
+                return { 
+                    std::allocator_arg,
+                    alloc,
+                    result::ok(
+                        std::forward<F>(f)(std::move(*this).value())) };
+            }
+            return { 
+                std::allocator_arg,
+                alloc,
+                result::err(std::move(Base::stored_error())) };
         }
 
         template<typename F>
         auto map_err(F&& f) &&
-            -> Result<T, typename std::result_of<F(E&&)>::type>
+            -> Result<T, typename std::result_of<F(ErrorType&&)>::type>
         {
             if (!is_ok()) {
                 return result::err(
@@ -401,14 +736,42 @@ namespace result {
             if (is_ok()) {
                 return std::forward<F>(f)(std::move(*this).value());
             }
-            return result::err(std::move(*this).error());
+            return result::err(std::move(Base::stored_error()));
         }
 
+        //  As `and_then`, but the returned `Result` is constructed
+        //  with `alloc` (see the allocator-extended constructors).
         template<
+            typename A,
             typename F,
             typename R = 
                 typename std::remove_reference<
                     typename std::result_of<F(T&&)>::type>::type,
+            typename VT = 
+                typename traits::result_traits<R>::value_type,
+            typename 
+                std::enable_if<traits::is_result<R>::value>::type* = nullptr
+        >
+        auto and_then(std::allocator_arg_t, A const& alloc, F&& f) &&
+            -> Result<VT, E>
+        {
+            if (is_ok()) {
+                return { 
+                    std::allocator_arg,
+                    alloc,
+                    std::forward<F>(f)(std::move(*this).value()) };
+            }
+            return { 
+                std::allocator_arg,
+                alloc,
+                result::err(std::move(Base::stored_error())) };
+        }
+
+        template<
+            typename F,
+            typename R = 
+                typename std::remove_reference<
+                    typename std::result_of<F(ErrorType&&)>::type>::type,
             typename ET = 
                 typename traits::result_traits<R>::value_type,
             typename 
@@ -428,6 +791,58 @@ namespace result {
             }
             return std::forward<F>(f)();
         }
+
+        //  Calls `f` with the error, if there is one, and passes the
+        //  `Result` on unchanged; e.g. for logging (see
+        //  `result/log.hpp`).
+        template<typename F>
+        auto inspect_err(F&& f) & -> Result& {
+            if (Base::tag() == Base::UnionTag::Error) {
+                std::forward<F>(f)(static_cast<ErrorType const&>(error()));
+            }
+            return *this;
+        }
+
+        template<typename F>
+        auto inspect_err(F&& f) const& -> Result const& {
+            if (Base::tag() == Base::UnionTag::Error) {
+                std::forward<F>(f)(error());
+            }
+            return *this;
+        }
+
+        template<typename F>
+        auto inspect_err(F&& f) && -> Result {
+            inspect_err(std::forward<F>(f));
+            return std::move(*this);
+        }
+
+        //  Collapses `Result<Result<U, E>, E>` (nested to any depth)
+        //  into `Result<U, E>`. Inner errors must be convertible to
+        //  `E`. Whichever value or error ends up in the result is
+        //  moved exactly once.
+        template<
+            typename U = T,
+            typename 
+                std::enable_if<traits::is_result<U>::value>::type* = nullptr
+        >
+        auto flatten() && -> detail::flattened_t<Result> {
+            return detail::flatten_into<detail::flattened_t<Result>>(
+                *this, std::true_type{});
+        }
+
+        //  The error-side counterpart of `flatten()`: collapses
+        //  `Result<T, Result<T, E>>` into `Result<T, E>`. An inner
+        //  success is a success of the whole.
+        template<
+            typename U = E,
+            typename 
+                std::enable_if<traits::is_result<U>::value>::type* = nullptr
+        >
+        auto join() && -> detail::joined_t<Result> {
+            return detail::join_into<detail::joined_t<Result>>(
+                *this, std::true_type{});
+        }
     };
 
     template<typename E>
@@ -436,6 +851,7 @@ namespace result {
     {
 
         using Base = detail::Storage<detail::VoidType, E>;
+        using ErrorType = typename detail::ErrorAccess<E>::type;
 
         Result(detail::Ok<detail::VoidType> ok) noexcept :
             Base{ok}
@@ -447,17 +863,74 @@ namespace result {
             Base{std::move(err)}
         { }
 
+        template<typename A>
+        Result(std::allocator_arg_t, 
+               A const&, 
+               detail::Ok<detail::VoidType> ok) noexcept :
+            Base{ok}
+        { }
+
+        template<typename A, typename U>
+        Result(std::allocator_arg_t, A const& alloc, detail::Err<U> err) :
+            Base{std::allocator_arg, alloc, std::move(err)}
+        { }
+
+        template<typename A>
+        Result(std::allocator_arg_t, A const& alloc, Result&& other) :
+            Base{std::allocator_arg, alloc, static_cast<Base&&>(other)}
+        { }
+
+        template<typename A>
+        Result(std::allocator_arg_t, A const& alloc, Result const& other) :
+            Base{std::allocator_arg, alloc, static_cast<Base const&>(other)}
+        { }
+
+        //  See `Result<T, E>`'s converting constructors.
+        template<
+            typename F,
+            typename 
+                std::enable_if<
+                    detail::widens_error<F, E>::value &&
+                        traits::is_one_of<E>::value>::type* = nullptr
+        >
+        Result(Result<void, F>&& other) :
+            Result{detail::Widen{}, std::move(other)}
+        { }
+
+        template<
+            typename F,
+            typename 
+                std::enable_if<
+                    detail::widens_error<F, E>::value &&
+                        !traits::is_one_of<E>::value>::type* = nullptr
+        >
+        explicit Result(Result<void, F>&& other) :
+            Result{detail::Widen{}, std::move(other)}
+        { }
+
+        template<typename F>
+        Result(detail::Widen, Result<void, F>&& other) :
+            Base{}
+        {
+            if (other.is_ok()) {
+                Base::emplace_value(detail::VoidType{});
+            }
+            else {
+                Base::emplace_error(std::move(other).error());
+            }
+        }
+
         Result() = delete;
 
         friend auto operator==(Result const& lhs,
                                Result const& rhs) noexcept 
             -> bool
         {
-            return (lhs.tag_ == rhs.tag_) &&
-                (lhs.tag_ == Base::UnionTag::Empty ||
-                lhs.tag_ == Base::UnionTag::Value ||
-                (lhs.tag_ == Base::UnionTag::Error &&
-                    lhs.storage_.error == rhs.storage_.error));
+            return (lhs.tag() == rhs.tag()) &&
+                (lhs.tag() == Base::UnionTag::Empty ||
+                lhs.tag() == Base::UnionTag::Value ||
+                (lhs.tag() == Base::UnionTag::Error &&
+                    lhs.stored_error() == rhs.stored_error()));
         }
 
         friend auto operator!=(Result const& lhs,
@@ -468,26 +941,26 @@ namespace result {
         }
 
         auto is_ok() const noexcept -> bool {
-            return Base::tag_ == Base::UnionTag::Value;
+            return Base::tag() == Base::UnionTag::Value;
         }
 
         operator bool() const {
             return is_ok();
         }
 
-        auto error() & -> E& {
-            if (Base::tag_ != Base::UnionTag::Error) {
+        auto error() & -> ErrorType& {
+            if (Base::tag() != Base::UnionTag::Error) {
                 throw BadResultAccess { "The result doesn't contain an error" };
             }
 
-            return Base::storage_.error;
+            return detail::ErrorAccess<E>::get(Base::stored_error());
         }
 
-        auto error() const& -> const E& {
+        auto error() const& -> const ErrorType& {
             return const_cast<Result&>(*this).error();
         }
 
-        auto error() && -> E&& {
+        auto error() && -> ErrorType&& {
             return std::move(error());
         }
 
@@ -498,12 +971,12 @@ namespace result {
             if (is_ok()) {
                 return result::ok(std::forward<F>(f)());
             }
-            return result::err(std::move(*this).error());
+            return result::err(std::move(Base::stored_error()));
         }
 
         template<typename F>
         auto map_err(F&& f) &&
-            -> Result<void, typename std::result_of<F(E&&)>::type>
+            -> Result<void, typename std::result_of<F(ErrorType&&)>::type>
         {
             if (!is_ok()) {
                 return result::err(
@@ -516,7 +989,7 @@ namespace result {
             typename F,
             typename R = 
                 typename std::remove_reference<
-                    typename std::result_of<F(T&&)>::type>::type,
+                    typename std::result_of<F(ErrorType&&)>::type>::type,
             typename ET = 
                 typename traits::result_traits<R>::value_type,
             typename 
@@ -528,6 +1001,40 @@ namespace result {
             }
             return result::ok();
         }
+
+        //  See `Result<T, E>::inspect_err()`.
+        template<typename F>
+        auto inspect_err(F&& f) & -> Result& {
+            if (Base::tag() == Base::UnionTag::Error) {
+                std::forward<F>(f)(static_cast<ErrorType const&>(error()));
+            }
+            return *this;
+        }
+
+        template<typename F>
+        auto inspect_err(F&& f) const& -> Result const& {
+            if (Base::tag() == Base::UnionTag::Error) {
+                std::forward<F>(f)(error());
+            }
+            return *this;
+        }
+
+        template<typename F>
+        auto inspect_err(F&& f) && -> Result {
+            inspect_err(std::forward<F>(f));
+            return std::move(*this);
+        }
+
+        //  See `Result<T, E>::join()`.
+        template<
+            typename U = E,
+            typename 
+                std::enable_if<traits::is_result<U>::value>::type* = nullptr
+        >
+        auto join() && -> detail::joined_t<Result> {
+            return detail::join_into<detail::joined_t<Result>>(
+                *this, std::true_type{});
+        }
     };
 
     template<typename T, typename E>
@@ -570,6 +1077,12 @@ namespace result {
         return std::move(r).map(std::forward<F>(f));
     }
 
+    template<typename A, typename T, typename E, typename F>
+    auto map(std::allocator_arg_t, A const& alloc, Result<T, E>&& r, F&& f) {
+        return std::move(r).map(
+            std::allocator_arg, alloc, std::forward<F>(f));
+    }
+
     template<typename T, typename E, typename F>
     auto map_err(Result<T, E>&& r, F&& f) {
         return std::move(r).map_err(std::forward<F>(f));
@@ -580,9 +1093,66 @@ namespace result {
         return std::move(r).and_then(std::forward<F>(f));
     }
 
+    template<typename A, typename T, typename E, typename F>
+    auto and_then(std::allocator_arg_t, 
+                  A const& alloc, 
+                  Result<T, E>&& r, 
+                  F&& f) 
+    {
+        return std::move(r).and_then(
+            std::allocator_arg, alloc, std::forward<F>(f));
+    }
+
     template<typename T, typename E, typename F>
     auto or_else(Result<T, E>&& r, F&& f) {
         return std::move(r).or_else(std::forward<F>(f));
     }
+
+    template<typename T, typename E, typename F>
+    auto inspect_err(Result<T, E>& r, F&& f) -> Result<T, E>& {
+        return r.inspect_err(std::forward<F>(f));
+    }
+
+    template<typename T, typename E, typename F>
+    auto inspect_err(Result<T, E> const& r, F&& f) -> Result<T, E> const& {
+        return r.inspect_err(std::forward<F>(f));
+    }
+
+    template<typename T, typename E, typename F>
+    auto inspect_err(Result<T, E>&& r, F&& f) -> Result<T, E> {
+        return std::move(r).inspect_err(std::forward<F>(f));
+    }
+
+    template<typename T, typename E>
+    auto flatten(Result<T, E>&& r) {
+        return std::move(r).flatten();
+    }
+
+    template<typename T, typename E>
+    auto join(Result<T, E>&& r) {
+        return std::move(r).join();
+    }
+}
+
+namespace std {
+    //  Lets allocator-aware containers of `Result`s (e.g. a
+    //  `std::pmr::vector<Result<std::pmr::string, E>>`) pass their
+    //  allocator on to the elements' values and errors.
+    template<typename T, typename E, typename A>
+    struct uses_allocator<result::Result<T, E>, A> :
+        integral_constant<
+            bool,
+            uses_allocator<T, A>::value || uses_allocator<E, A>::value>
+    { };
 }
+
+#ifndef RESULT_EXTERN_TEMPLATES
+#define RESULT_EXTERN_TEMPLATES 0
+#endif
+
+//  Common `Result`s instantiated once, in `Result::instantiations`.
+#if RESULT_EXTERN_TEMPLATES
+#include "result/instantiations.hpp"
+#endif
+
 #endif //RESULT_RESULT_HPP_INCLUDED
@@ -0,0 +1,224 @@
+#ifndef RESULT_RETRY_HPP_INCLUDED
+#define RESULT_RETRY_HPP_INCLUDED
+
+#include "result/result.hpp"
+#include "result/thread_pool.hpp"
+#include "result/traits.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace result {
+
+    //  The source of time for `retry`. Substitute anything with the
+    //  same members (e.g. a fake clock that advances on
+    //  `sleep_for`) for deterministic tests.
+    struct SteadyTimer {
+        using clock = std::chrono::steady_clock;
+        using duration = clock::duration;
+        using time_point = clock::time_point;
+
+        static auto now() -> time_point { return clock::now(); }
+
+        static auto sleep_for(duration d) -> void {
+            std::this_thread::sleep_for(d);
+        }
+    };
+
+    //  Describes when and how often `retry` should try again.
+    //  `is_transient` is called with each error and decides
+    //  whether it's worth another attempt. Backoff starts at
+    //  `initial_backoff` and is multiplied by `multiplier` after
+    //  each attempt (capped at `max_backoff`); each delay is then
+    //  reduced by a random fraction of up to `jitter`. No attempt
+    //  is started that couldn't begin before `deadline` elapses.
+    template<typename Classifier, typename Timer = SteadyTimer>
+    struct RetryPolicy {
+        using timer_type = Timer;
+        using duration = typename Timer::duration;
+
+        Classifier is_transient;
+        size_t max_attempts = 5;
+        duration initial_backoff =
+            std::chrono::duration_cast<duration>(
+                std::chrono::milliseconds { 10 });
+        duration max_backoff =
+            std::chrono::duration_cast<duration>(
+                std::chrono::seconds { 1 });
+        double multiplier = 2.0;
+        double jitter = 0.5;
+        duration deadline = duration::max();
+        uint64_t seed = std::random_device{}();
+    };
+
+    template<typename Timer = SteadyTimer, typename Classifier>
+    auto retry_policy(Classifier&& is_transient)
+        -> RetryPolicy<typename std::decay<Classifier>::type, Timer>
+    {
+        return { std::forward<Classifier>(is_transient) };
+    }
+
+    //  Calls `f` until it succeeds, fails with an error that
+    //  `policy.is_transient` rejects, or the policy's attempts or
+    //  deadline run out. The last result is returned either way.
+    template<
+        typename Classifier,
+        typename Timer,
+        typename F,
+        typename R = typename std::decay<
+            typename std::result_of<F&()>::type>::type,
+        typename std::enable_if<traits::is_result<R>::value>::type*
+            = nullptr>
+    auto retry(RetryPolicy<Classifier, Timer> const& policy, F&& f) -> R {
+        using duration = typename Timer::duration;
+
+        auto const start = Timer::now();
+        auto const remaining = [&] {
+            auto elapsed = Timer::now() - start;
+            return elapsed >= policy.deadline
+                ? duration::zero()
+                : policy.deadline - elapsed;
+        };
+
+        std::minstd_rand rng {
+            static_cast<std::minstd_rand::result_type>(policy.seed) };
+        std::uniform_real_distribution<double> unit { 0.0, 1.0 };
+        auto backoff = policy.initial_backoff;
+
+        for (size_t attempt = 1; ; ++attempt) {
+            R r = f();
+            if (r.is_ok() ||
+                attempt >= policy.max_attempts ||
+                !policy.is_transient(r.error()))
+            {
+                return r;
+            }
+
+            auto delay = std::chrono::duration_cast<duration>(
+                backoff * (1.0 - policy.jitter * unit(rng)));
+            if (delay >= remaining()) {
+                return r;
+            }
+
+            Timer::sleep_for(delay);
+
+            auto next = std::chrono::duration_cast<duration>(
+                backoff * policy.multiplier);
+            backoff = next < policy.max_backoff ? next : policy.max_backoff;
+        }
+    }
+
+    namespace detail {
+        template<typename R>
+        struct HedgeState {
+            std::mutex mutex;
+            std::condition_variable done;
+            std::unique_ptr<R> result;
+            std::exception_ptr exception;
+
+            auto finished() const -> bool {
+                return result || exception;
+            }
+        };
+
+        template<typename R, typename F>
+        auto hedge_attempt(std::shared_ptr<HedgeState<R>> state,
+                           std::shared_ptr<F> f) -> void
+        {
+            std::unique_ptr<R> r;
+            std::exception_ptr e;
+            try {
+                r.reset(new R{(*f)()});
+            }
+            catch (...) {
+                e = std::current_exception();
+            }
+
+            {
+                std::lock_guard<std::mutex> lock { state->mutex };
+                if (state->finished()) {
+                    return;
+                }
+                state->result = std::move(r);
+                state->exception = e;
+            }
+            state->done.notify_all();
+        }
+
+        //  Attempts block their worker, so a pool sized to the core
+        //  count would leave a second attempt queued behind the first
+        //  on a single core machine. Twice the cores (and never fewer
+        //  than two workers) leaves room for every first attempt's
+        //  hedge.
+        inline auto hedge_pool() -> ThreadPool& {
+            static ThreadPool pool {
+                2 * std::max(std::thread::hardware_concurrency(), 1u) };
+            return pool;
+        }
+    }
+
+    //  Runs `f` on `pool` and, if it hasn't completed within
+    //  `delay`, runs it a second time in parallel; whichever
+    //  attempt finishes first provides the result. The slower
+    //  attempt is left to run to completion and its result is
+    //  discarded, so `f` must be safe to call concurrently.
+    //
+    //  `hedge` doesn't wait for the slower attempt: it may still be
+    //  running after `hedge` returns, and after the caller's stack
+    //  frame is gone. `f` is copied (or moved) into shared state, but
+    //  whatever it refers to must outlive that attempt, so capture
+    //  by value or through a `shared_ptr`, not with `[&]`.
+    template<
+        typename F,
+        typename Rep,
+        typename Period,
+        typename R = typename std::decay<
+            typename std::result_of<F&()>::type>::type,
+        typename std::enable_if<traits::is_result<R>::value>::type*
+            = nullptr>
+    auto hedge(ThreadPool& pool,
+               F&& f,
+               std::chrono::duration<Rep, Period> delay) -> R
+    {
+        using Fn = typename std::decay<F>::type;
+
+        auto state = std::make_shared<detail::HedgeState<R>>();
+        auto fn = std::make_shared<Fn>(std::forward<F>(f));
+
+        pool.submit([state, fn] { detail::hedge_attempt(state, fn); });
+
+        std::unique_lock<std::mutex> lock { state->mutex };
+        if (!state->done.wait_for(lock,
+                                  delay,
+                                  [&] { return state->finished(); }))
+        {
+            pool.submit([state, fn] { detail::hedge_attempt(state, fn); });
+            state->done.wait(lock, [&] { return state->finished(); });
+        }
+
+        if (state->exception) {
+            std::rethrow_exception(state->exception);
+        }
+
+        return std::move(*state->result);
+    }
+
+    //  As above, on a shared pool with two workers per core. Once
+    //  more than a core's worth of hedged calls are blocked at once,
+    //  later attempts queue and aren't hedged promptly; give those
+    //  callers a `ThreadPool` of their own.
+    template<typename F, typename Rep, typename Period>
+    auto hedge(F&& f, std::chrono::duration<Rep, Period> delay) {
+        return hedge(detail::hedge_pool(), std::forward<F>(f), delay);
+    }
+}
+
+#endif //RESULT_RETRY_HPP_INCLUDED
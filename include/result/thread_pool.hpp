@@ -0,0 +1,239 @@
+#ifndef RESULT_THREAD_POOL_HPP_INCLUDED
+#define RESULT_THREAD_POOL_HPP_INCLUDED
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace result {
+
+    //  A fixed-size pool of worker threads. Tasks still queued when
+    //  the pool is destroyed are run before the workers are joined.
+    struct ThreadPool {
+
+        using task_type = std::function<void()>;
+
+        explicit ThreadPool(size_t threads =
+                                std::thread::hardware_concurrency())
+        {
+            if (!threads) {
+                threads = 1;
+            }
+
+            workers_.reserve(threads);
+            for (size_t i = 0; i < threads; ++i) {
+                workers_.emplace_back([this] { run(); });
+            }
+        }
+
+        ThreadPool(ThreadPool const&) = delete;
+        auto operator=(ThreadPool const&) -> ThreadPool& = delete;
+
+        ~ThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock { mutex_ };
+                stopping_ = true;
+            }
+            ready_.notify_all();
+
+            for (auto& w : workers_) {
+                w.join();
+            }
+        }
+
+        auto size() const noexcept -> size_t {
+            return workers_.size();
+        }
+
+        auto submit(task_type task) -> void {
+            {
+                std::lock_guard<std::mutex> lock { mutex_ };
+                tasks_.push_back(std::move(task));
+            }
+            ready_.notify_one();
+        }
+
+    private:
+        auto run() -> void {
+            for (;;) {
+                task_type task;
+                {
+                    std::unique_lock<std::mutex> lock { mutex_ };
+                    ready_.wait(lock, [this] {
+                        return stopping_ || !tasks_.empty();
+                    });
+
+                    if (tasks_.empty()) {
+                        return;
+                    }
+
+                    task = std::move(tasks_.front());
+                    tasks_.pop_front();
+                }
+                task();
+            }
+        }
+
+        std::mutex mutex_;
+        std::condition_variable ready_;
+        std::deque<task_type> tasks_;
+        bool stopping_ = false;
+        std::vector<std::thread> workers_;
+    };
+
+    //  A pool where each worker has its own queue. Tasks submitted
+    //  from a worker go to that worker's queue and are run newest
+    //  first; idle workers steal the oldest tasks from the others.
+    //  Threads waiting on pool work can lend a hand with
+    //  `try_run_one()`.
+    struct WorkStealingPool {
+
+        using task_type = std::function<void()>;
+
+        explicit WorkStealingPool(size_t threads =
+                                      std::thread::hardware_concurrency()) :
+            size_{threads ? threads : 1}
+        ,   queues_{new Queue[size_]}
+        {
+            workers_.reserve(size_);
+            for (size_t i = 0; i < size_; ++i) {
+                workers_.emplace_back([this, i] { run(i); });
+            }
+        }
+
+        WorkStealingPool(WorkStealingPool const&) = delete;
+        auto operator=(WorkStealingPool const&)
+            -> WorkStealingPool& = delete;
+
+        ~WorkStealingPool() {
+            {
+                std::lock_guard<std::mutex> lock { sleep_mutex_ };
+                stopping_ = true;
+            }
+            wake_.notify_all();
+
+            for (auto& w : workers_) {
+                w.join();
+            }
+        }
+
+        auto size() const noexcept -> size_t {
+            return size_;
+        }
+
+        auto submit(task_type task) -> void {
+            auto index = current().pool == this
+                ? current().index
+                : next_.fetch_add(1, std::memory_order_relaxed) % size_;
+
+            //  Counted before it's queued so that `take()` can never
+            //  see the count go below zero.
+            pending_.fetch_add(1, std::memory_order_release);
+            {
+                std::lock_guard<std::mutex> lock { queues_[index].mutex };
+                queues_[index].tasks.push_back(std::move(task));
+            }
+
+            {
+                std::lock_guard<std::mutex> lock { sleep_mutex_ };
+            }
+            wake_.notify_one();
+        }
+
+        //  Runs one queued task, if there is one, on the calling
+        //  thread.
+        auto try_run_one() -> bool {
+            auto home = current().pool == this ? current().index : 0;
+            task_type task;
+            if (!take(home, task)) {
+                return false;
+            }
+            task();
+            return true;
+        }
+
+    private:
+        struct Queue {
+            std::mutex mutex;
+            std::deque<task_type> tasks;
+        };
+
+        struct Current {
+            WorkStealingPool* pool;
+            size_t index;
+        };
+
+        static auto current() -> Current& {
+            static thread_local Current c { nullptr, 0 };
+            return c;
+        }
+
+        auto take(size_t home, task_type& task) -> bool {
+            {
+                auto& own = queues_[home];
+                std::lock_guard<std::mutex> lock { own.mutex };
+                if (!own.tasks.empty()) {
+                    task = std::move(own.tasks.back());
+                    own.tasks.pop_back();
+                    pending_.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+
+            for (size_t i = 1; i < size_; ++i) {
+                auto& victim = queues_[(home + i) % size_];
+                std::lock_guard<std::mutex> lock { victim.mutex };
+                if (!victim.tasks.empty()) {
+                    task = std::move(victim.tasks.front());
+                    victim.tasks.pop_front();
+                    pending_.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        auto run(size_t index) -> void {
+            current() = Current { this, index };
+
+            for (;;) {
+                task_type task;
+                if (take(index, task)) {
+                    task();
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock { sleep_mutex_ };
+                wake_.wait(lock, [this] {
+                    return stopping_ ||
+                        pending_.load(std::memory_order_acquire) > 0;
+                });
+
+                if (stopping_ &&
+                    pending_.load(std::memory_order_acquire) == 0)
+                {
+                    return;
+                }
+            }
+        }
+
+        size_t size_;
+        std::unique_ptr<Queue[]> queues_;
+        std::atomic<size_t> next_ { 0 };
+        std::atomic<size_t> pending_ { 0 };
+        std::mutex sleep_mutex_;
+        std::condition_variable wake_;
+        bool stopping_ = false;
+        std::vector<std::thread> workers_;
+    };
+}
+
+#endif //RESULT_THREAD_POOL_HPP_INCLUDED
@@ -1,6 +1,7 @@
 #ifndef RESULT_TRAITS_HPP_INCLUDED
 #define RESULT_TRAITS_HPP_INCLUDED
 
+#include <memory>
 #include <type_traits>
 
 namespace result { 
@@ -8,6 +9,9 @@ namespace result {
     template<typename T, typename E>
     struct Result;
 
+    template<typename... Es>
+    struct OneOf;
+
     namespace detail {
         template<typename T>
         struct Ok;
@@ -35,6 +39,14 @@ namespace traits {
     struct is_result<detail::Err<E>> : std::true_type
     { };
 
+    template<typename T>
+    struct is_one_of : std::false_type
+    { };
+
+    template<typename... Es>
+    struct is_one_of<OneOf<Es...>> : std::true_type
+    { };
+
     namespace _ {
         template<typename... Ts>
         using void_t = void;
@@ -142,6 +154,47 @@ namespace traits {
         using error_type = 
             typename inner_impl<T, E>::error_type;
     };
+
+    //  A type is *trivially relocatable* if moving it to a new
+    //  address and then destroying the original is equivalent to
+    //  a `memcpy` of its bytes. Trivially copyable types always
+    //  are. Specialize this for your own types where it holds
+    //  (e.g. types that own heap memory through a pointer but
+    //  never point into themselves).
+    template<typename T>
+    struct is_trivially_relocatable : 
+        std::is_trivially_copyable<T>
+    { };
+
+    template<typename T, typename E>
+    struct is_trivially_relocatable<Result<T, E>> :
+        std::integral_constant<
+            bool,
+            is_trivially_relocatable<T>::value &&
+                is_trivially_relocatable<E>::value>
+    { };
+
+    template<typename E>
+    struct is_trivially_relocatable<Result<void, E>> :
+        is_trivially_relocatable<E>
+    { };
+
+    //  The smart pointers only hold pointers to their targets (or
+    //  control blocks) and never into themselves, so every
+    //  mainstream implementation can be relocated bitwise. These
+    //  live here, next to the primary template, so that every TU
+    //  sees the same answer for e.g. `Result<std::unique_ptr<T>, E>`.
+    template<typename T>
+    struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type
+    { };
+
+    template<typename T>
+    struct is_trivially_relocatable<std::shared_ptr<T>> : std::true_type
+    { };
+
+    template<typename T>
+    struct is_trivially_relocatable<std::weak_ptr<T>> : std::true_type
+    { };
 }}
 
 #endif //RESULT_TRAITS_HPP_INCLUDED
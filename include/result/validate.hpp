@@ -0,0 +1,366 @@
+#ifndef RESULT_VALIDATE_HPP_INCLUDED
+#define RESULT_VALIDATE_HPP_INCLUDED
+
+#include "result/result.hpp"
+#include "result/traits.hpp"
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace result {
+
+    //  A list of errors with room for `N` of them inline. Anything
+    //  beyond that spills into a single buffer obtained from
+    //  `Allocator`. `reserve()` up front and it's guaranteed to
+    //  allocate at most once.
+    template<
+        typename E,
+        size_t N = 4,
+        typename Allocator = std::allocator<E>>
+    struct ErrorList {
+
+        using value_type = E;
+        using size_type = size_t;
+        using iterator = E*;
+        using const_iterator = E const*;
+        using allocator_type =
+            typename std::allocator_traits<Allocator>::
+                template rebind_alloc<E>;
+
+        static constexpr size_t inline_capacity = N;
+
+        ErrorList() noexcept(noexcept(allocator_type{})) :
+            alloc_{}
+        { }
+
+        explicit ErrorList(Allocator const& alloc) noexcept :
+            alloc_{alloc}
+        { }
+
+        ErrorList(ErrorList&& other)
+            noexcept(std::is_nothrow_move_constructible<E>::value) :
+            alloc_{other.alloc_}
+        {
+            take(std::move(other));
+        }
+
+        ErrorList(ErrorList const& other) :
+            alloc_{
+                std::allocator_traits<allocator_type>::
+                    select_on_container_copy_construction(other.alloc_)}
+        {
+            //  The destructor won't run if this throws.
+            try {
+                reserve(other.size_);
+                for (auto const& e : other) {
+                    push_back(e);
+                }
+            }
+            catch (...) {
+                reset();
+                throw;
+            }
+        }
+
+        //  Assignment keeps this list's allocator. If moving an
+        //  error throws, the list keeps the errors moved so far.
+        auto operator=(ErrorList&& other)
+            noexcept(AllocTraits::is_always_equal::value &&
+                     std::is_nothrow_move_constructible<E>::value)
+            -> ErrorList&
+        {
+            if (this != &other) {
+                reset();
+                take(std::move(other));
+            }
+            return *this;
+        }
+
+        //  A throwing copy leaves the list as it was.
+        auto operator=(ErrorList const& other) -> ErrorList& {
+            if (this != &other) {
+                ErrorList copy { other };
+                reset();
+                take(std::move(copy));
+            }
+            return *this;
+        }
+
+        ~ErrorList() {
+            reset();
+        }
+
+        auto size() const noexcept -> size_t { return size_; }
+        auto capacity() const noexcept -> size_t { return capacity_; }
+        auto empty() const noexcept -> bool { return size_ == 0; }
+
+        auto begin() noexcept -> iterator { return data_; }
+        auto end() noexcept -> iterator { return data_ + size_; }
+        auto begin() const noexcept -> const_iterator { return data_; }
+        auto end() const noexcept -> const_iterator {
+            return data_ + size_;
+        }
+
+        auto operator[](size_t n) noexcept -> E& { return data_[n]; }
+        auto operator[](size_t n) const noexcept -> E const& {
+            return data_[n];
+        }
+
+        auto get_allocator() const noexcept -> allocator_type {
+            return alloc_;
+        }
+
+        auto reserve(size_t n) -> void {
+            if (n <= capacity_) {
+                return;
+            }
+
+            //  The old errors are only destroyed once they've all
+            //  been moved (or copied, if moving might throw).
+            auto new_data = AllocTraits::allocate(alloc_, n);
+            size_t moved = 0;
+            try {
+                for (; moved < size_; ++moved) {
+                    new (static_cast<void*>(new_data + moved)) E{
+                        std::move_if_noexcept(data_[moved])};
+                }
+            }
+            catch (...) {
+                while (moved) {
+                    new_data[--moved].~E();
+                }
+                AllocTraits::deallocate(alloc_, new_data, n);
+                throw;
+            }
+
+            for (size_t i = 0; i < size_; ++i) {
+                data_[i].~E();
+            }
+
+            if (!is_inline()) {
+                AllocTraits::deallocate(alloc_, data_, capacity_);
+            }
+            data_ = new_data;
+            capacity_ = n;
+        }
+
+        template<typename... Args>
+        auto emplace_back(Args&&... args) -> E& {
+            if (size_ == capacity_) {
+                reserve(capacity_ ? capacity_ * 2 : 1);
+            }
+            new (static_cast<void*>(data_ + size_)) E{
+                std::forward<Args>(args)...};
+            return data_[size_++];
+        }
+
+        auto push_back(E&& e) -> void {
+            emplace_back(std::move(e));
+        }
+
+        auto push_back(E const& e) -> void {
+            emplace_back(e);
+        }
+
+        auto clear() noexcept -> void {
+            for (auto& e : *this) {
+                e.~E();
+            }
+            size_ = 0;
+        }
+
+        friend auto operator==(ErrorList const& lhs, ErrorList const& rhs)
+            -> bool
+        {
+            if (lhs.size_ != rhs.size_) {
+                return false;
+            }
+            for (size_t i = 0; i < lhs.size_; ++i) {
+                if (!(lhs.data_[i] == rhs.data_[i])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        friend auto operator!=(ErrorList const& lhs, ErrorList const& rhs)
+            -> bool
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        using AllocTraits = std::allocator_traits<allocator_type>;
+
+        auto inline_data() noexcept -> E* {
+            return reinterpret_cast<E*>(&inline_);
+        }
+
+        auto is_inline() noexcept -> bool {
+            return data_ == inline_data();
+        }
+
+        //  Destroys every error and returns to the inline buffer.
+        auto reset() noexcept -> void {
+            clear();
+            if (!is_inline()) {
+                AllocTraits::deallocate(alloc_, data_, capacity_);
+                data_ = inline_data();
+                capacity_ = N;
+            }
+        }
+
+        //  Moves `other`'s errors into this empty, inline list. Its
+        //  buffer is taken over when our allocators can free each
+        //  other's memory; otherwise the errors are moved one by one.
+        auto take(ErrorList&& other) -> void {
+            if (!other.is_inline() && alloc_ == other.alloc_) {
+                data_ = other.data_;
+                size_ = other.size_;
+                capacity_ = other.capacity_;
+                other.data_ = other.inline_data();
+                other.size_ = 0;
+                other.capacity_ = N;
+                return;
+            }
+
+            reserve(other.size_);
+            for (auto& e : other) {
+                new (static_cast<void*>(data_ + size_)) E{std::move(e)};
+                ++size_;
+            }
+            other.clear();
+        }
+
+        allocator_type alloc_;
+        typename std::aligned_storage<
+            sizeof(E) * (N ? N : 1),
+            alignof(E)>::type inline_;
+        E* data_ = inline_data();
+        size_t size_ = 0;
+        size_t capacity_ = N;
+    };
+
+    //  A `Result` that carries every error found, rather than just
+    //  the first.
+    template<
+        typename T,
+        typename E,
+        typename Allocator = std::allocator<E>>
+    using Validated = Result<T, ErrorList<E, 4, Allocator>>;
+
+    namespace detail {
+        template<typename R>
+        using validated_value_t =
+            typename traits::result_traits<
+                typename std::decay<R>::type>::value_type;
+
+        template<typename R>
+        using validated_error_t =
+            typename traits::result_traits<
+                typename std::decay<R>::type>::error_type;
+
+        template<typename E, typename... Rs>
+        struct all_errors_are : std::true_type
+        { };
+
+        template<typename E, typename R, typename... Rs>
+        struct all_errors_are<E, R, Rs...> :
+            std::integral_constant<
+                bool,
+                std::is_same<E, validated_error_t<R>>::value &&
+                    all_errors_are<E, Rs...>::value>
+        { };
+
+        template<typename... Ts>
+        struct any_void : std::false_type
+        { };
+
+        template<typename T, typename... Ts>
+        struct any_void<T, Ts...> :
+            std::integral_constant<
+                bool,
+                std::is_void<T>::value || any_void<Ts...>::value>
+        { };
+
+        template<typename List, typename R>
+        auto collect_error(List& errors, R&& r) -> int {
+            if (!r.is_ok()) {
+                errors.push_back(std::forward<R>(r).error());
+            }
+            return 0;
+        }
+    }
+
+    //  Unlike `and_then`, doesn't stop at the first error; every
+    //  failed input contributes to the resulting `ErrorList`. The
+    //  number of failures is known before any is stored, so this
+    //  allocates at most once (and not at all if they fit inline).
+    template<
+        typename Allocator,
+        typename R,
+        typename... Rs,
+        typename E = detail::validated_error_t<R>>
+    auto validate(std::allocator_arg_t,
+                  Allocator const& alloc,
+                  R&& r,
+                  Rs&&... rs)
+        -> Validated<
+            std::tuple<
+                detail::validated_value_t<R>,
+                detail::validated_value_t<Rs>...>,
+            E,
+            Allocator>
+    {
+        static_assert(detail::all_errors_are<E, Rs...>::value,
+                      "All results must have the same error type");
+        static_assert(
+            !detail::any_void<
+                detail::validated_value_t<R>,
+                detail::validated_value_t<Rs>...>::value,
+            "`Result<void, E>` can't be validated into a tuple");
+
+        bool const is_ok[] = { r.is_ok(), rs.is_ok()... };
+        size_t failed = 0;
+        for (auto ok : is_ok) {
+            failed += ok ? 0 : 1;
+        }
+
+        if (failed) {
+            ErrorList<E, 4, Allocator> errors { alloc };
+            errors.reserve(failed);
+            int const swallow[] = {
+                detail::collect_error(errors, std::forward<R>(r)),
+                detail::collect_error(errors, std::forward<Rs>(rs))...
+            };
+            static_cast<void>(swallow);
+            return result::err(std::move(errors));
+        }
+
+        return result::ok(
+            std::tuple<
+                detail::validated_value_t<R>,
+                detail::validated_value_t<Rs>...> {
+                    std::forward<R>(r).value(),
+                    std::forward<Rs>(rs).value()... });
+    }
+
+    template<
+        typename R,
+        typename... Rs,
+        typename E = detail::validated_error_t<R>,
+        typename std::enable_if<
+            traits::is_result<typename std::decay<R>::type>::value
+        >::type* = nullptr>
+    auto validate(R&& r, Rs&&... rs) {
+        return validate(std::allocator_arg,
+                        std::allocator<E>{},
+                        std::forward<R>(r),
+                        std::forward<Rs>(rs)...);
+    }
+}
+
+#endif //RESULT_VALIDATE_HPP_INCLUDED
@@ -0,0 +1,394 @@
+#ifndef RESULT_WHEN_HPP_INCLUDED
+#define RESULT_WHEN_HPP_INCLUDED
+
+#include "result/result.hpp"
+#include "result/thread_pool.hpp"
+#include "result/traits.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace result {
+
+    //  Observes whether the `CancellationSource` it came from has been
+    //  cancelled. Cancellation is cooperative; long running tasks
+    //  should check `is_cancelled()` at convenient points.
+    struct CancellationToken {
+
+        auto is_cancelled() const noexcept -> bool {
+            return flag_ && flag_->load(std::memory_order_acquire);
+        }
+
+    private:
+        friend struct CancellationSource;
+
+        explicit CancellationToken(
+            std::shared_ptr<std::atomic<bool>> flag) noexcept :
+            flag_{std::move(flag)}
+        { }
+
+        std::shared_ptr<std::atomic<bool>> flag_;
+    };
+
+    struct CancellationSource {
+
+        CancellationSource() :
+            flag_{std::make_shared<std::atomic<bool>>(false)}
+        { }
+
+        auto token() const noexcept -> CancellationToken {
+            return CancellationToken { flag_ };
+        }
+
+        auto cancel() noexcept -> void {
+            flag_->store(true, std::memory_order_release);
+        }
+
+        auto is_cancelled() const noexcept -> bool {
+            return flag_->load(std::memory_order_acquire);
+        }
+
+    private:
+        std::shared_ptr<std::atomic<bool>> flag_;
+    };
+
+    namespace detail {
+
+        struct NoToken { };
+        struct PreferTokenTag : NoToken { };
+
+        //  Tasks may take a `CancellationToken const&`, or nothing
+        //  at all.
+        template<typename F>
+        auto invoke_task(F& f, CancellationToken const& token, PreferTokenTag)
+            -> decltype(f(token))
+        {
+            return f(token);
+        }
+
+        template<typename F>
+        auto invoke_task(F& f, CancellationToken const&, NoToken)
+            -> decltype(f())
+        {
+            return f();
+        }
+
+        template<typename F>
+        using task_result_t =
+            typename std::decay<
+                decltype(invoke_task(std::declval<F&>(),
+                                     std::declval<CancellationToken const&>(),
+                                     PreferTokenTag{}))>::type;
+
+        template<typename F>
+        using task_value_t =
+            typename traits::result_traits<task_result_t<F>>::value_type;
+
+        template<typename F>
+        using task_error_t =
+            typename traits::result_traits<task_result_t<F>>::error_type;
+
+        //  Space for a `T` that's filled in later (by another thread).
+        template<typename T>
+        struct Slot {
+            Slot() = default;
+            Slot(Slot const&) = delete;
+
+            ~Slot() {
+                if (engaged_) {
+                    get().~T();
+                }
+            }
+
+            template<typename U>
+            auto emplace(U&& value) -> void {
+                new (static_cast<void*>(&storage_)) T{std::forward<U>(value)};
+                engaged_ = true;
+            }
+
+            auto get() noexcept -> T& {
+                return *reinterpret_cast<T*>(&storage_);
+            }
+
+        private:
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type
+                storage_;
+            bool engaged_ = false;
+        };
+
+        template<typename E, typename... Ts>
+        struct WhenAllState {
+            std::mutex mutex;
+            std::condition_variable done;
+            size_t remaining = sizeof...(Ts);
+            bool failed = false;
+            Slot<E> error;
+            std::exception_ptr exception;
+            std::tuple<Slot<Ts>...> values;
+            CancellationSource cancellation;
+
+            auto finished() const -> bool {
+                return failed || remaining == 0;
+            }
+
+            auto finish_one() -> void {
+                {
+                    std::lock_guard<std::mutex> lock { mutex };
+                    --remaining;
+                }
+                done.notify_all();
+            }
+
+            auto fail(E&& e) -> void {
+                {
+                    std::lock_guard<std::mutex> lock { mutex };
+                    if (!failed) {
+                        failed = true;
+                        error.emplace(std::move(e));
+                        cancellation.cancel();
+                    }
+                    --remaining;
+                }
+                done.notify_all();
+            }
+
+            //  A task that throws fails the whole `when_all`, just as
+            //  an error would.
+            auto fail(std::exception_ptr e) -> void {
+                {
+                    std::lock_guard<std::mutex> lock { mutex };
+                    if (!failed) {
+                        failed = true;
+                        exception = std::move(e);
+                        cancellation.cancel();
+                    }
+                    --remaining;
+                }
+                done.notify_all();
+            }
+        };
+
+        template<size_t I, typename State, typename F>
+        auto when_all_task(std::shared_ptr<State> const& state, F& f)
+            -> void
+        {
+            if (state->cancellation.is_cancelled()) {
+                state->finish_one();
+                return;
+            }
+
+            //  Exceptions mustn't escape into the pool's worker; they're
+            //  rethrown from `when_all` instead.
+            try {
+                auto r = invoke_task(f,
+                                     state->cancellation.token(),
+                                     PreferTokenTag{});
+                if (r.is_ok()) {
+                    std::get<I>(state->values).emplace(std::move(r).value());
+                    state->finish_one();
+                }
+                else {
+                    state->fail(std::move(r).error());
+                }
+            }
+            catch (...) {
+                state->fail(std::current_exception());
+            }
+        }
+
+        template<typename Pool, typename State>
+        auto wait_helping(Pool& pool, State& state) -> void {
+            for (;;) {
+                {
+                    std::lock_guard<std::mutex> lock { state.mutex };
+                    if (state.finished()) {
+                        return;
+                    }
+                }
+
+                //  Lend a hand while there's queued work, otherwise
+                //  what's left of ours is already running.
+                if (!pool.try_run_one()) {
+                    std::unique_lock<std::mutex> lock { state.mutex };
+                    state.done.wait(lock, [&] { return state.finished(); });
+                    return;
+                }
+            }
+        }
+
+        template<
+            typename Pool,
+            typename... Fs,
+            size_t... Is,
+            typename E = task_error_t<
+                typename std::tuple_element<0, std::tuple<Fs...>>::type>>
+        auto when_all_impl(Pool& pool,
+                           std::index_sequence<Is...>,
+                           Fs&&... fs)
+            -> Result<std::tuple<task_value_t<Fs>...>, E>
+        {
+            using State = WhenAllState<E, task_value_t<Fs>...>;
+            auto state = std::make_shared<State>();
+
+            int const submitted[] = {
+                (pool.submit(
+                    [state, f = typename std::decay<Fs>::type {
+                        std::forward<Fs>(fs) }]() mutable {
+                        when_all_task<Is>(state, f);
+                    }), 0)...
+            };
+            static_cast<void>(submitted);
+
+            wait_helping(pool, *state);
+
+            std::lock_guard<std::mutex> lock { state->mutex };
+            if (state->exception) {
+                std::rethrow_exception(state->exception);
+            }
+            if (state->failed) {
+                return result::err(std::move(state->error.get()));
+            }
+
+            return result::ok(std::tuple<task_value_t<Fs>...> {
+                std::move(std::get<Is>(state->values).get())... });
+        }
+
+        template<typename T, typename E>
+        struct WhenAnyState {
+            std::mutex mutex;
+            std::condition_variable done;
+            size_t remaining;
+            bool succeeded = false;
+            Slot<T> value;
+            Slot<E> last_error;
+            std::exception_ptr last_exception;
+            CancellationSource cancellation;
+
+            explicit WhenAnyState(size_t count) :
+                remaining{count}
+            { }
+
+            auto finished() const -> bool {
+                return succeeded || remaining == 0;
+            }
+        };
+
+        template<typename State, typename F>
+        auto when_any_task(std::shared_ptr<State> const& state, F& f)
+            -> void
+        {
+            if (state->cancellation.is_cancelled()) {
+                {
+                    std::lock_guard<std::mutex> lock { state->mutex };
+                    --state->remaining;
+                }
+                state->done.notify_all();
+                return;
+            }
+
+            try {
+                auto r = invoke_task(f,
+                                     state->cancellation.token(),
+                                     PreferTokenTag{});
+                {
+                    std::lock_guard<std::mutex> lock { state->mutex };
+                    --state->remaining;
+                    if (r.is_ok()) {
+                        if (!state->succeeded) {
+                            state->succeeded = true;
+                            state->value.emplace(std::move(r).value());
+                            state->cancellation.cancel();
+                        }
+                    }
+                    else if (!state->succeeded && state->remaining == 0) {
+                        state->last_error.emplace(std::move(r).error());
+                    }
+                }
+            }
+            catch (...) {
+                //  A task that throws counts as failing; `when_any`
+                //  rethrows if it was the last one to finish.
+                std::lock_guard<std::mutex> lock { state->mutex };
+                --state->remaining;
+                if (!state->succeeded && state->remaining == 0) {
+                    state->last_exception = std::current_exception();
+                }
+            }
+            state->done.notify_all();
+        }
+    }
+
+    //  Runs each task on `pool` and gathers their values into a
+    //  tuple. Tasks return `Result<Ti, E>` (the `Ti`s may differ, the
+    //  `E` may not) and may optionally take a `CancellationToken`.
+    //  The first error is returned as soon as it occurs; tasks that
+    //  haven't started by then are skipped, and running ones see
+    //  their token cancelled. A task that throws fails the call the
+    //  same way, and its exception is rethrown here.
+    //
+    //  `when_all` doesn't wait for those running tasks: when it
+    //  returns early with an error, they may still be running, and
+    //  may outlive the caller's stack frame. Tasks that outlive it
+    //  must not capture the caller's locals by reference; capture
+    //  by value or through a `shared_ptr`.
+    template<typename F, typename... Fs>
+    auto when_all(WorkStealingPool& pool, F&& f, Fs&&... fs) {
+        return detail::when_all_impl(
+            pool,
+            std::index_sequence_for<F, Fs...>{},
+            std::forward<F>(f),
+            std::forward<Fs>(fs)...);
+    }
+
+    //  Runs each task on `pool` and returns the first successful
+    //  value, cancelling the rest. If every task fails, the error
+    //  of the last one to finish is returned (or rethrown, if that
+    //  task threw). All tasks must return the same `Result<T, E>`.
+    //  As with `when_all`, the tasks that lose may still be running
+    //  when this returns, so they mustn't capture the caller's locals
+    //  by reference.
+    template<typename F, typename... Fs>
+    auto when_any(WorkStealingPool& pool, F&& f, Fs&&... fs)
+        -> Result<detail::task_value_t<F>, detail::task_error_t<F>>
+    {
+        using T = detail::task_value_t<F>;
+        using E = detail::task_error_t<F>;
+        using State = detail::WhenAnyState<T, E>;
+
+        auto state = std::make_shared<State>(1 + sizeof...(Fs));
+
+        int const submitted[] = {
+            (pool.submit(
+                [state, task = typename std::decay<F>::type {
+                    std::forward<F>(f) }]() mutable {
+                    detail::when_any_task(state, task);
+                }), 0),
+            (pool.submit(
+                [state, task = typename std::decay<Fs>::type {
+                    std::forward<Fs>(fs) }]() mutable {
+                    detail::when_any_task(state, task);
+                }), 0)...
+        };
+        static_cast<void>(submitted);
+
+        detail::wait_helping(pool, *state);
+
+        std::lock_guard<std::mutex> lock { state->mutex };
+        if (state->succeeded) {
+            return result::ok(std::move(state->value.get()));
+        }
+        if (state->last_exception) {
+            std::rethrow_exception(state->last_exception);
+        }
+        return result::err(std::move(state->last_error.get()));
+    }
+}
+
+#endif //RESULT_WHEN_HPP_INCLUDED
@@ -0,0 +1,6 @@
+#include "result/instantiations.hpp"
+
+//  The one place the common `Result`s are instantiated; see
+//  `result/instantiations.hpp`.
+RESULT_COMMON_INSTANTIATIONS(RESULT_INSTANTIATE_TEMPLATE,
+                             RESULT_INSTANTIATE_TEMPLATE_VOID);
@@ -0,0 +1,101 @@
+#include "result/result.hpp"
+#include "catch2/catch.hpp"
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace {
+    using PmrVector = std::pmr::vector<int>;
+    using PmrString = std::pmr::string;
+    using R = result::Result<PmrVector, PmrString>;
+
+    auto resource_of(PmrVector const& v) -> std::pmr::memory_resource* {
+        return v.get_allocator().resource();
+    }
+
+    auto resource_of(PmrString const& s) -> std::pmr::memory_resource* {
+        return s.get_allocator().resource();
+    }
+}
+
+TEST_CASE("Allocator-extended construction uses the allocator",
+          "[allocator]")
+{
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::polymorphic_allocator<char> alloc { &arena };
+
+    R ok { std::allocator_arg, alloc, result::ok(PmrVector { 1, 2, 3 }) };
+    REQUIRE(resource_of(ok.value()) == &arena);
+    REQUIRE(ok.value().size() == 3);
+
+    R err {
+        std::allocator_arg,
+        alloc,
+        result::err(PmrString { "a string too long for the small buffer" })
+    };
+    REQUIRE(resource_of(err.error()) == &arena);
+
+    R copy { std::allocator_arg, alloc, R { result::ok(PmrVector { 4 }) } };
+    REQUIRE(resource_of(copy.value()) == &arena);
+}
+
+TEST_CASE("Allocator-aware containers propagate into Results",
+          "[allocator]")
+{
+    using Element = result::Result<PmrString, int>;
+
+    REQUIRE(
+        std::uses_allocator<
+            Element, std::pmr::polymorphic_allocator<char>>::value);
+    REQUIRE(
+        !std::uses_allocator<
+            result::Result<int, int>,
+            std::pmr::polymorphic_allocator<char>>::value);
+
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::vector<Element> elements { &arena };
+
+    elements.push_back(result::ok(
+        PmrString { "a string too long for the small buffer" }));
+    elements.emplace_back(result::err(42));
+
+    REQUIRE(resource_of(elements[0].value()) == &arena);
+    REQUIRE(elements[1].error() == 42);
+}
+
+TEST_CASE("map and and_then propagate the allocator", "[allocator]") {
+
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::polymorphic_allocator<char> alloc { &arena };
+
+    R r { std::allocator_arg, alloc, result::ok(PmrVector { 1, 2, 3 }) };
+
+    auto mapped = std::move(r).map(std::allocator_arg, alloc,
+                                   [](PmrVector v) {
+        v.push_back(4);
+        return v;
+    });
+    REQUIRE(resource_of(mapped.value()) == &arena);
+    REQUIRE(mapped.value().size() == 4);
+
+    auto chained = result::and_then(
+        std::allocator_arg,
+        alloc,
+        std::move(mapped),
+        [](PmrVector v) -> R {
+            //  Built in the default resource...
+            return result::ok(PmrVector { v.begin(), v.end() });
+        });
+
+    //  ...but moved into the arena.
+    REQUIRE(resource_of(chained.value()) == &arena);
+    REQUIRE(chained.value().size() == 4);
+
+    R failed { std::allocator_arg, alloc, result::err(PmrString { "e" }) };
+    auto still_failed = result::map(std::allocator_arg,
+                                    alloc,
+                                    std::move(failed),
+                                    [](PmrVector v) { return v; });
+    REQUIRE(resource_of(still_failed.error()) == &arena);
+}
@@ -0,0 +1,140 @@
+#include "result/boxed.hpp"
+#include "result/result.hpp"
+#include "catch2/catch.hpp"
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+    struct RichError {
+        int code;
+        char context[192];
+        std::string message;
+
+        friend auto operator==(RichError const& lhs, RichError const& rhs)
+            -> bool
+        {
+            return lhs.code == rhs.code && lhs.message == rhs.message;
+        }
+    };
+
+    auto rich(int code, std::string message) -> RichError {
+        return RichError { code, { }, std::move(message) };
+    }
+
+    using Boxed = result::Result<int, result::Boxed<RichError>>;
+}
+
+TEST_CASE("Boxed errors keep Results small", "[boxed]") {
+
+    static_assert(sizeof(result::Result<int, RichError>) > 200,
+                  "the unboxed Result is as big as its error");
+    static_assert(sizeof(Boxed) <= sizeof(int) + 2 * sizeof(void*),
+                  "the boxed Result is a value, a pointer and a tag");
+
+    static_assert(
+        std::is_same<
+            result::CompactResult<int, RichError>,
+            Boxed>::value,
+        "large errors are boxed");
+    static_assert(
+        std::is_same<
+            result::CompactResult<int, int>,
+            result::Result<int, int>>::value,
+        "small errors aren't");
+}
+
+TEST_CASE("Boxed errors keep the error() API", "[boxed]") {
+
+    auto r = Boxed { result::err(rich(42, "disk on fire")) };
+    REQUIRE(!r);
+
+    RichError& e = r.error();
+    REQUIRE(e.code == 42);
+    REQUIRE(r.error().message == "disk on fire");
+
+    auto copy = r;
+    REQUIRE(copy == r);
+    copy.error().code = 7;
+    REQUIRE(copy != r);
+
+    auto moved = std::move(copy);
+    REQUIRE(moved.error().code == 7);
+
+    auto ok = Boxed { result::ok(1) };
+    REQUIRE(ok.value() == 1);
+}
+
+TEST_CASE("Moving a Boxed error hands its block over", "[boxed]") {
+
+    static_assert(std::is_nothrow_move_constructible<
+                      result::Result<std::string,
+                                     result::Boxed<RichError>>>::value,
+                  "vectors of boxed Results move rather than copy");
+
+    auto a = Boxed { result::err(rich(5, "gone")) };
+    auto const* block = &a.error();
+    auto b = std::move(a);
+    REQUIRE(&b.error() == block);
+    REQUIRE(b.error().message == "gone");
+
+    //  `a` is empty now; it can be copied, compared and assigned to.
+    auto c = a;
+    REQUIRE(c == a);
+    REQUIRE(c != b);
+    c = std::move(b);
+    REQUIRE(c.error().message == "gone");
+
+    a = Boxed { result::err(rich(6, "back")) };
+    REQUIRE(a.error().message == "back");
+}
+
+TEST_CASE("Combinators see through Boxed", "[boxed]") {
+
+    auto mapped = Boxed { result::err(rich(1, "a")) }
+        .map([](int v) { return v * 2; })
+        .and_then([](int v) -> Boxed { return result::ok(v + 1); });
+    static_assert(std::is_same<decltype(mapped), Boxed>::value,
+                  "map and and_then keep the error boxed");
+    REQUIRE(mapped.error().message == "a");
+
+    auto code = std::move(mapped).map_err([](RichError&& e) {
+        return e.code;
+    });
+    REQUIRE(code.error() == 1);
+
+    auto recovered = Boxed { result::err(rich(3, "b")) }
+        .or_else([](RichError e) {
+            return result::ok(e.code);
+        });
+    REQUIRE(recovered.value() == 3);
+
+    result::Result<int, RichError> unboxed = result::err(rich(9, "c"));
+    Boxed widened { std::move(unboxed) };
+    REQUIRE(widened.error().code == 9);
+}
+
+TEST_CASE("Boxed errors are recycled across threads", "[boxed]") {
+
+    std::vector<Boxed> errors;
+    for (int i = 0; i < 100; ++i) {
+        errors.push_back(Boxed { result::err(rich(i, "x")) });
+    }
+
+    int matched = 0;
+    std::thread t { [&errors, &matched] {
+        errors.clear();
+        for (int i = 0; i < 100; ++i) {
+            auto r = Boxed { result::err(rich(i, "y")) };
+            matched += r.error().code == i;
+        }
+    } };
+    t.join();
+    REQUIRE(matched == 100);
+
+    auto r = Boxed { result::err(rich(100, "z")) };
+    REQUIRE(r.error().code == 100);
+}
@@ -0,0 +1,86 @@
+#include "result/fault.hpp"
+#include "result/result.hpp"
+#include "catch2/catch.hpp"
+#include <string>
+#include <system_error>
+
+//  This file is built with `RESULT_ENABLE_FAULT_INJECTION=1` (see
+//  `tests/CMakeLists.txt`).
+
+namespace {
+    using IoResult = result::Result<size_t, std::error_code>;
+
+    auto injected_read(char const* site) -> IoResult {
+        return result::inject<std::error_code>(
+            site,
+            IoResult { result::ok(size_t { 42 }) },
+            [] { return std::make_error_code(std::errc::io_error); });
+    }
+
+    auto count_failures(char const* site, size_t calls) -> size_t {
+        size_t failures = 0;
+        for (size_t i = 0; i < calls; ++i) {
+            if (!injected_read(site)) {
+                ++failures;
+            }
+        }
+        return failures;
+    }
+}
+
+TEST_CASE("Unconfigured sites never fail", "[fault]") {
+
+    REQUIRE(count_failures("fault_tests.unconfigured", 1000) == 0);
+}
+
+TEST_CASE("Sites fail at roughly the configured rate", "[fault]") {
+
+    auto& registry = result::fault::Registry::instance();
+
+    REQUIRE(registry.configure("fault_tests.quarter", 0.25, 1));
+    auto failures = count_failures("fault_tests.quarter", 10000);
+    REQUIRE(failures > 2000);
+    REQUIRE(failures < 3000);
+    REQUIRE(registry.injected("fault_tests.quarter") == failures);
+
+    REQUIRE(registry.configure("fault_tests.always", 1.0));
+    REQUIRE(count_failures("fault_tests.always", 100) == 100);
+    REQUIRE(injected_read("fault_tests.always").error() ==
+            std::errc::io_error);
+
+    REQUIRE(registry.configure("fault_tests.never", 0.0));
+    REQUIRE(count_failures("fault_tests.never", 100) == 0);
+}
+
+TEST_CASE("The same seed injects the same faults", "[fault]") {
+
+    auto& registry = result::fault::Registry::instance();
+
+    auto pattern = [&] {
+        registry.configure("fault_tests.seeded", 0.5, 1234);
+        std::string p;
+        for (int i = 0; i < 64; ++i) {
+            p += injected_read("fault_tests.seeded") ? '.' : 'x';
+        }
+        return p;
+    };
+
+    REQUIRE(pattern() == pattern());
+}
+
+TEST_CASE("Errors pass through untouched and clear() stops faults",
+          "[fault]")
+{
+    auto& registry = result::fault::Registry::instance();
+    registry.configure("fault_tests.cleared", 1.0);
+
+    auto r = result::inject<std::error_code>(
+        "fault_tests.cleared",
+        IoResult { result::err(
+            std::make_error_code(std::errc::timed_out)) },
+        [] { return std::make_error_code(std::errc::io_error); });
+    REQUIRE(r.error() == std::errc::timed_out);
+
+    registry.clear();
+    REQUIRE(count_failures("fault_tests.cleared", 100) == 0);
+}
@@ -0,0 +1,159 @@
+#include "result/io_ring.hpp"
+#include "result/io.hpp"
+#include "result/result.hpp"
+#include "catch2/catch.hpp"
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+    using result::io::IoRing;
+    using result::io::IoRingBackend;
+    using result::io::ReadRequest;
+
+    struct TempFile {
+        TempFile(std::string const& contents) {
+            char name[] = "/tmp/result_io_ring_tests_XXXXXX";
+            auto fd = ::mkstemp(name);
+            REQUIRE(fd >= 0);
+            path = name;
+            REQUIRE(result::io::write_all(fd,
+                                          contents.data(),
+                                          contents.size()).is_ok());
+            ::close(fd);
+        }
+
+        ~TempFile() {
+            ::unlink(path.c_str());
+        }
+
+        std::string path;
+    };
+
+    auto check_batch_reads(IoRing& ring) -> void {
+
+        std::string contents;
+        for (int i = 0; i < 64; ++i) {
+            contents += std::string(16, static_cast<char>('a' + i % 26));
+        }
+
+        TempFile file { contents };
+        auto fd = result::io::open(file.path.c_str(), O_RDONLY).value();
+
+        std::vector<std::string> buffers(64, std::string(16, '\0'));
+        std::vector<ReadRequest> requests;
+        for (size_t i = 0; i < buffers.size(); ++i) {
+            requests.push_back(ReadRequest {
+                fd.get(),
+                &buffers[i][0],
+                16,
+                static_cast<off_t>(i * 16),
+                i });
+        }
+
+        //  One read from a bad descriptor, and one past end of file.
+        char scratch[16];
+        requests.push_back(ReadRequest { -1, scratch, 16, 0, 64 });
+        requests.push_back(
+            ReadRequest { fd.get(), scratch, 16, 1 << 20, 65 });
+
+        std::vector<result::io::IoResult<size_t>> results(
+            requests.size(), result::ok(size_t { 99 }));
+
+        REQUIRE(ring.read_batch(requests.data(),
+                                requests.size(),
+                                results.data()).is_ok());
+        REQUIRE(ring.in_flight() == 0);
+
+        for (size_t i = 0; i < 64; ++i) {
+            REQUIRE(results[i].value() == 16);
+            REQUIRE(buffers[i] == contents.substr(i * 16, 16));
+        }
+
+        REQUIRE(results[64].error() == std::errc::bad_file_descriptor);
+        REQUIRE(results[65].value() == 0);
+    }
+}
+
+TEST_CASE("IoRing reads batches with the thread backend", "[io_ring]") {
+
+    auto ring = IoRing::create(8, IoRingBackend::Threads);
+    REQUIRE(ring.is_ok());
+    REQUIRE(ring.value().backend() == IoRingBackend::Threads);
+    REQUIRE(ring.value().capacity() == 8);
+
+    check_batch_reads(ring.value());
+}
+
+TEST_CASE("IoRing reads batches with the default backend", "[io_ring]") {
+
+    auto ring = IoRing::create(8);
+    REQUIRE(ring.is_ok());
+
+    check_batch_reads(ring.value());
+}
+
+TEST_CASE("IoRing uses io_uring when it can be set up", "[io_ring]") {
+
+    auto uring = IoRing::create(8, IoRingBackend::IoUring);
+    if (!uring) {
+        WARN("io_uring unavailable: " << uring.error().message());
+        return;
+    }
+
+    REQUIRE(uring.value().backend() == IoRingBackend::IoUring);
+    check_batch_reads(uring.value());
+
+    //  ...and then it's what the default picks, too.
+    REQUIRE(IoRing::create(8).value().backend() == IoRingBackend::IoUring);
+}
+
+TEST_CASE("IoRing rejects reads too long for every backend", "[io_ring]") {
+
+    TempFile file { "0123456789" };
+    auto fd = result::io::open(file.path.c_str(), O_RDONLY).value();
+
+    char buffer[2];
+    ReadRequest requests[2] = {
+        ReadRequest { fd.get(), buffer, 2, 0, 0 },
+        ReadRequest { fd.get(), buffer, IoRing::max_read_length + 1, 0, 1 }
+    };
+
+    for (auto backend : { IoRingBackend::Auto, IoRingBackend::Threads }) {
+        auto ring = IoRing::create(4, backend).value();
+
+        REQUIRE(ring.submit(requests, 2).value() == 1);
+        REQUIRE(ring.submit(requests + 1, 1).error() ==
+                std::errc::invalid_argument);
+        REQUIRE(ring.in_flight() == 1);
+
+        std::vector<result::io::IoResult<size_t>> results(
+            2, result::ok(size_t { 0 }));
+        REQUIRE(ring.wait(results.data(), 1).value() == 1);
+        REQUIRE(results[0].value() == 2);
+    }
+}
+
+TEST_CASE("IoRing submits no more than its capacity", "[io_ring]") {
+
+    TempFile file { "0123456789" };
+    auto fd = result::io::open(file.path.c_str(), O_RDONLY).value();
+    auto ring = IoRing::create(2).value();
+
+    char buffers[4][2];
+    ReadRequest requests[4];
+    for (size_t i = 0; i < 4; ++i) {
+        requests[i] = ReadRequest {
+            fd.get(), buffers[i], 2, static_cast<off_t>(i * 2), i };
+    }
+
+    REQUIRE(ring.submit(requests, 4).value() == 2);
+    REQUIRE(ring.in_flight() == 2);
+
+    std::vector<result::io::IoResult<size_t>> results(
+        4, result::ok(size_t { 0 }));
+    REQUIRE(ring.wait(results.data(), 2).value() == 2);
+    REQUIRE(ring.in_flight() == 0);
+    REQUIRE(results[1].value() == 2);
+    REQUIRE(std::string(buffers[1], 2) == "23");
+}
@@ -0,0 +1,115 @@
+#include "result/io.hpp"
+#include "result/result.hpp"
+#include "catch2/catch.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace {
+    //  A temporary file on the local filesystem, removed on
+    //  destruction.
+    struct TempFile {
+        TempFile(std::string const& contents = {}) {
+            char name[] = "/tmp/result_io_tests_XXXXXX";
+            auto fd = ::mkstemp(name);
+            REQUIRE(fd >= 0);
+            path = name;
+            REQUIRE(result::io::write_all(fd,
+                                          contents.data(),
+                                          contents.size()).is_ok());
+            ::close(fd);
+        }
+
+        ~TempFile() {
+            ::unlink(path.c_str());
+        }
+
+        std::string path;
+    };
+}
+
+TEST_CASE("open reports errors as error codes", "[io]") {
+
+    auto r = result::io::open("/nonexistent/result/io/test", O_RDONLY);
+
+    REQUIRE(!r.is_ok());
+    REQUIRE(r.error() == std::errc::no_such_file_or_directory);
+}
+
+TEST_CASE("read, pread and readv", "[io]") {
+
+    TempFile file { "hello, world" };
+    auto fd = result::io::open(file.path.c_str(), O_RDONLY).value();
+
+    char buffer[5];
+    REQUIRE(result::io::read(fd.get(), buffer, 5).value() == 5);
+    REQUIRE(std::string(buffer, 5) == "hello");
+
+    REQUIRE(result::io::pread(fd.get(), buffer, 5, 7).value() == 5);
+    REQUIRE(std::string(buffer, 5) == "world");
+
+    char a[2];
+    char b[5];
+    iovec iov[] = { { a, sizeof(a) }, { b, sizeof(b) } };
+    REQUIRE(result::io::readv(fd.get(), iov, 2).value() == 7);
+    REQUIRE(std::string(a, 2) == ", ");
+    REQUIRE(std::string(b, 5) == "world");
+
+    REQUIRE(result::io::read(fd.get(), buffer, 5).value() == 0);
+}
+
+TEST_CASE("read_all stops at end of file", "[io]") {
+
+    TempFile file { "short" };
+    auto fd = result::io::open(file.path.c_str(), O_RDONLY).value();
+
+    char buffer[32];
+    REQUIRE(result::io::read_all(fd.get(), buffer, sizeof(buffer))
+                .value() == 5);
+    REQUIRE(result::io::pread_all(fd.get(), buffer, sizeof(buffer), 1)
+                .value() == 4);
+}
+
+TEST_CASE("write, writev and fstat", "[io]") {
+
+    TempFile file;
+    auto fd = result::io::open(file.path.c_str(), O_WRONLY).value();
+
+    REQUIRE(result::io::write(fd.get(), "abc", 3).value() == 3);
+
+    char d[] = "de";
+    char f[] = "f";
+    iovec iov[] = { { d, 2 }, { f, 1 } };
+    REQUIRE(result::io::writev(fd.get(), iov, 2).value() == 3);
+
+    REQUIRE(result::io::fstat(fd.get()).value().st_size == 6);
+    REQUIRE(fd.close().is_ok());
+    REQUIRE(!fd);
+
+    REQUIRE(!result::io::read(-1, d, 1).is_ok());
+}
+
+TEST_CASE("MappedFile views the whole file without copying", "[io]") {
+
+    TempFile file { "mapped contents" };
+
+    auto mapped = result::io::MappedFile::open(file.path.c_str());
+    REQUIRE(mapped.is_ok());
+
+    auto view = mapped.value().view().value();
+    REQUIRE(view.size() == 15);
+    REQUIRE(std::string(view.begin(), view.end()) == "mapped contents");
+
+    auto moved = std::move(mapped).value();
+    REQUIRE(moved.view().value().data() == view.data());
+}
+
+TEST_CASE("MappedFile handles empty and missing files", "[io]") {
+
+    TempFile empty;
+    auto mapped = result::io::MappedFile::open(empty.path.c_str());
+    REQUIRE(mapped.value().view().value().empty());
+
+    auto missing = result::io::MappedFile::open("/nonexistent/mapped");
+    REQUIRE(missing.error() == std::errc::no_such_file_or_directory);
+}
@@ -0,0 +1,132 @@
+#include "result/lazy.hpp"
+#include "result/result.hpp"
+#include "catch2/catch.hpp"
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("LazyResult computes once across threads", "[lazy]") {
+
+    std::atomic<int> calls { 0 };
+    result::LazyResult<std::string, int> lazy { [&]()
+        -> result::Result<std::string, int>
+    {
+        ++calls;
+        std::this_thread::yield();
+        return result::ok(std::string { "index" });
+    }};
+
+    REQUIRE(!lazy.is_initialized());
+    REQUIRE(lazy.try_get() == nullptr);
+
+    std::vector<std::thread> threads;
+    std::atomic<int> matched { 0 };
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&] {
+            if (lazy.get().value() == "index") {
+                ++matched;
+            }
+        });
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    REQUIRE(calls == 1);
+    REQUIRE(matched == 4);
+    REQUIRE(lazy.is_initialized());
+    REQUIRE(&lazy.get() == lazy.try_get());
+}
+
+TEST_CASE("LazyResult caches errors by default", "[lazy]") {
+
+    int calls = 0;
+    result::LazyResult<int, std::string> lazy { [&]()
+        -> result::Result<int, std::string>
+    {
+        ++calls;
+        return result::err(std::string { "missing" });
+    }};
+
+    REQUIRE(lazy.get().error() == "missing");
+    REQUIRE(lazy.get().error() == "missing");
+    REQUIRE(calls == 1);
+}
+
+TEST_CASE("LazyResult can retry after an error", "[lazy]") {
+
+    int calls = 0;
+    result::LazyResult<
+        int,
+        std::string,
+        result::LazyErrorPolicy::Retry> lazy { [&]()
+            -> result::Result<int, std::string>
+    {
+        if (++calls < 3) {
+            return result::err(std::string { "not yet" });
+        }
+        return result::ok(calls);
+    }};
+
+    REQUIRE(lazy.get().error() == "not yet");
+    REQUIRE(!lazy.is_initialized());
+    REQUIRE(lazy.get().error() == "not yet");
+    REQUIRE(lazy.get().value() == 3);
+    REQUIRE(lazy.get().value() == 3);
+    REQUIRE(calls == 3);
+
+    //  Once it has succeeded, the result is handed out by reference.
+    REQUIRE(&lazy.get() == lazy.try_get());
+}
+
+TEST_CASE("LazyResult retries safely across threads", "[lazy]") {
+
+    std::atomic<int> calls { 0 };
+    result::LazyResult<
+        int,
+        std::string,
+        result::LazyErrorPolicy::Retry> lazy { [&]()
+            -> result::Result<int, std::string>
+    {
+        ++calls;
+        return result::err(std::string { "still down, try again later" });
+    }};
+
+    std::vector<std::thread> threads;
+    std::atomic<int> matched { 0 };
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < 2000; ++j) {
+                auto const& r = lazy.get();
+                if (!r && r.error() == "still down, try again later") {
+                    ++matched;
+                }
+            }
+        });
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    REQUIRE(matched == 8000);
+    REQUIRE(calls >= 2000);
+    REQUIRE(!lazy.is_initialized());
+}
+
+TEST_CASE("LazyResult runs the factory again after it throws", "[lazy]") {
+
+    int calls = 0;
+    result::LazyResult<int, int> lazy { [&]() -> result::Result<int, int> {
+        if (++calls == 1) {
+            throw std::runtime_error { "boom" };
+        }
+        return result::ok(calls);
+    }};
+
+    REQUIRE_THROWS_AS(lazy.get(), std::runtime_error);
+    REQUIRE(lazy.get().value() == 2);
+}
@@ -0,0 +1,222 @@
+#include "result/log.hpp"
+#include "result/result.hpp"
+#include "catch2/catch.hpp"
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct Captured {
+        std::mutex mutex;
+        std::vector<std::string> lines;
+
+        auto snapshot() -> std::vector<std::string> {
+            std::lock_guard<std::mutex> lock { mutex };
+            return lines;
+        }
+    };
+
+    //  The sink's thread never gets to drain on its own in these
+    //  tests, so what's written is decided by the `flush()` calls.
+    auto capture(std::shared_ptr<Captured> const& out,
+                 uint32_t burst = 1000)
+        -> result::ErrorSink::Options
+    {
+        result::ErrorSink::Options options;
+        options.burst = burst;
+        options.lines_per_second = 0;
+        options.poll_interval = std::chrono::hours { 1 };
+        options.write = [out](char const* line, size_t n) {
+            std::lock_guard<std::mutex> lock { out->mutex };
+            out->lines.emplace_back(line, n);
+        };
+        return options;
+    }
+
+    auto fails(int code) -> result::Result<int, int> {
+        return result::err(code);
+    }
+}
+
+TEST_CASE("inspect_err only sees errors", "[log]") {
+
+    int seen = 0;
+    auto count = [&](int e) { seen += e; };
+
+    auto ok = result::Result<int, int> { result::ok(1) };
+    REQUIRE(ok.inspect_err(count).value() == 1);
+    REQUIRE(seen == 0);
+
+    auto r = fails(5).inspect_err(count);
+    REQUIRE(r.error() == 5);
+    REQUIRE(seen == 5);
+
+    result::Result<void, int> v = result::err(2);
+    result::inspect_err(v, count);
+    REQUIRE(seen == 7);
+}
+
+TEST_CASE("Logged errors are formatted off the calling thread", "[log]") {
+
+    auto out = std::make_shared<Captured>();
+    {
+        result::ErrorSink sink { capture(out) };
+
+        result::log_err(fails(3), sink, "parse");
+        auto r = result::Result<int, std::error_code> {
+            result::err(std::make_error_code(std::errc::timed_out)) };
+        r.inspect_err(result::log_to(sink, "connect"));
+        result::log_err(
+            result::Result<int, std::string> {
+                result::err(std::string { "no such user" }) },
+            sink,
+            "lookup");
+
+        sink.flush();
+
+        auto lines = out->snapshot();
+        REQUIRE(lines.size() == 3);
+        REQUIRE(lines[0] == "parse: error 3\n");
+        REQUIRE(lines[1] ==
+                "connect: generic:" +
+                std::to_string(static_cast<int>(std::errc::timed_out)) +
+                ": " +
+                std::make_error_code(std::errc::timed_out).message() +
+                "\n");
+        REQUIRE(lines[2] == "lookup: no such user\n");
+
+        auto stats = sink.stats();
+        REQUIRE(stats.logged == 3);
+        REQUIRE(stats.written == 3);
+    }
+}
+
+TEST_CASE("Identical consecutive errors are folded", "[log]") {
+
+    auto out = std::make_shared<Captured>();
+    {
+        result::ErrorSink sink { capture(out) };
+
+        for (int i = 0; i < 5; ++i) {
+            result::log_err(fails(1), sink, "read");
+        }
+        result::log_err(fails(2), sink, "read");
+        result::log_err(fails(2), sink, "write");
+        sink.flush();
+
+        auto lines = out->snapshot();
+        REQUIRE(lines.size() == 4);
+        REQUIRE(lines[0] == "read: error 1\n");
+        REQUIRE(lines[1] == "read: last error repeated 4 times\n");
+        REQUIRE(lines[2] == "read: error 2\n");
+        REQUIRE(lines[3] == "write: error 2\n");
+        REQUIRE(sink.stats().repeated == 4);
+    }
+}
+
+TEST_CASE("Errors beyond the rate limit are counted", "[log]") {
+
+    auto out = std::make_shared<Captured>();
+    {
+        result::ErrorSink sink { capture(out, 2) };
+
+        for (int i = 0; i < 10; ++i) {
+            result::log_err(fails(i), sink);
+        }
+        sink.flush();
+
+        auto lines = out->snapshot();
+        REQUIRE(lines.size() == 3);
+        REQUIRE(lines[0] == "error: error 0\n");
+        REQUIRE(lines[1] == "error: error 1\n");
+        REQUIRE(lines[2] == "result: suppressed 8 errors (rate limit)\n");
+
+        auto stats = sink.stats();
+        REQUIRE(stats.logged == 10);
+        REQUIRE(stats.suppressed == 8);
+    }
+}
+
+TEST_CASE("Full buffers drop errors rather than block", "[log]") {
+
+    auto out = std::make_shared<Captured>();
+    {
+        auto options = capture(out);
+        options.buffer_entries = 4;
+        result::ErrorSink sink { std::move(options) };
+
+        for (int i = 0; i < 10; ++i) {
+            result::log_err(fails(i), sink);
+        }
+        sink.flush();
+
+        auto stats = sink.stats();
+        REQUIRE(stats.logged == 4);
+        REQUIRE(stats.dropped == 6);
+        REQUIRE(out->snapshot().back() ==
+                "result: dropped 6 errors (buffer full)\n");
+    }
+}
+
+TEST_CASE("Each logging thread gets its own buffer", "[log]") {
+
+    auto out = std::make_shared<Captured>();
+    {
+        result::ErrorSink sink { capture(out) };
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&sink, t] {
+                for (int i = 0; i < 100; ++i) {
+                    result::log_err(fails(t * 1000 + i), sink);
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        sink.flush();
+
+        auto stats = sink.stats();
+        REQUIRE(stats.logged == 400);
+        REQUIRE(stats.dropped == 0);
+    }
+
+    //  Anything not flushed is written when the sink goes away.
+    auto out2 = std::make_shared<Captured>();
+    {
+        result::ErrorSink sink { capture(out2) };
+        result::log_err(fails(9), sink);
+    }
+    REQUIRE(out2->snapshot() ==
+            std::vector<std::string> { "error: error 9\n" });
+}
+
+TEST_CASE("Buffers of exited threads are drained and released", "[log]") {
+
+    auto out = std::make_shared<Captured>();
+    {
+        auto options = capture(out);
+        options.buffer_entries = 4;
+        result::ErrorSink sink { std::move(options) };
+
+        for (int t = 0; t < 50; ++t) {
+            std::thread { [&sink, t] {
+                for (int i = 0; i < 5; ++i) {
+                    result::log_err(fails(t), sink);
+                }
+            } }.join();
+            sink.flush();
+        }
+
+        //  Counts from released buffers aren't lost.
+        auto stats = sink.stats();
+        REQUIRE(stats.logged == 200);
+        REQUIRE(stats.dropped == 50);
+        REQUIRE(stats.buffers == 0);
+    }
+}
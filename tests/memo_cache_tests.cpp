@@ -0,0 +1,157 @@
+#include "result/memo_cache.hpp"
+#include "result/result.hpp"
+#include "catch2/catch.hpp"
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct FakeClock {
+        using duration = std::chrono::milliseconds;
+        using rep = duration::rep;
+        using period = duration::period;
+        using time_point = std::chrono::time_point<FakeClock>;
+        static constexpr bool is_steady = true;
+
+        static auto now() noexcept -> time_point { return current; }
+
+        static time_point current;
+    };
+
+    FakeClock::time_point FakeClock::current {};
+
+    using Cache = result::MemoCache<
+        int,
+        std::string,
+        int,
+        std::hash<int>,
+        std::equal_to<int>,
+        FakeClock>;
+}
+
+TEST_CASE("MemoCache caches successful values", "[memo_cache]") {
+
+    size_t calls = 0;
+    Cache cache { [&calls](int key) -> Cache::result_type {
+        ++calls;
+        return result::ok(std::to_string(key));
+    }};
+
+    REQUIRE(cache.get(1).value() == "1");
+    REQUIRE(cache.get(1).value() == "1");
+    REQUIRE(cache.get(2).value() == "2");
+    REQUIRE(calls == 2);
+
+    auto stats = cache.stats();
+    REQUIRE(stats.hits == 1);
+    REQUIRE(stats.misses == 2);
+
+    cache.invalidate(1);
+    REQUIRE(cache.get(1).value() == "1");
+    REQUIRE(calls == 3);
+}
+
+TEST_CASE("MemoCache expires errors by time and generation",
+          "[memo_cache]")
+{
+    size_t calls = 0;
+    Cache::Options options;
+    options.error_ttl = std::chrono::milliseconds { 100 };
+    options.error_generations = 2;
+
+    Cache cache { [&calls](int key) -> Cache::result_type {
+        ++calls;
+        return result::err(key);
+    }, options };
+
+    REQUIRE(cache.get(7).error() == 7);
+    REQUIRE(cache.get(7).error() == 7);
+    REQUIRE(calls == 1);
+
+    FakeClock::current += std::chrono::milliseconds { 100 };
+    REQUIRE(cache.get(7).error() == 7);
+    REQUIRE(calls == 2);
+
+    cache.next_generation();
+    REQUIRE(cache.get(7).error() == 7);
+    REQUIRE(calls == 2);
+
+    cache.next_generation();
+    REQUIRE(cache.get(7).error() == 7);
+    REQUIRE(calls == 3);
+}
+
+TEST_CASE("MemoCache can skip caching errors", "[memo_cache]") {
+
+    size_t calls = 0;
+    Cache::Options options;
+    options.cache_errors = false;
+
+    Cache cache { [&calls](int key) -> Cache::result_type {
+        ++calls;
+        return result::err(key);
+    }, options };
+
+    cache.get(1);
+    cache.get(1);
+    REQUIRE(calls == 2);
+}
+
+TEST_CASE("MemoCache coalesces concurrent misses", "[memo_cache]") {
+
+    constexpr int kThreads = 4;
+    std::atomic<int> calls { 0 };
+    Cache* cache_ptr = nullptr;
+
+    Cache cache { [&](int key) -> Cache::result_type {
+        ++calls;
+        //  Hold the computation open until every other thread is
+        //  waiting on it.
+        auto deadline =
+            std::chrono::steady_clock::now() + std::chrono::seconds { 5 };
+        while (cache_ptr->stats().coalesced < kThreads - 1 &&
+               std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::yield();
+        }
+        return result::ok(std::to_string(key));
+    }};
+    cache_ptr = &cache;
+
+    std::vector<std::thread> threads;
+    std::atomic<int> matched { 0 };
+    for (int i = 0; i < kThreads; ++i) {
+        threads.emplace_back([&] {
+            if (cache.get(42).value() == "42") {
+                ++matched;
+            }
+        });
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    REQUIRE(calls == 1);
+    REQUIRE(matched == kThreads);
+    REQUIRE(cache.stats().misses == 1);
+    REQUIRE(cache.stats().coalesced == kThreads - 1);
+}
+
+TEST_CASE("MemoCache propagates exceptions and forgets the key",
+          "[memo_cache]")
+{
+    bool fail = true;
+    Cache cache { [&fail](int key) -> Cache::result_type {
+        if (fail) {
+            throw std::runtime_error { "boom" };
+        }
+        return result::ok(std::to_string(key));
+    }};
+
+    REQUIRE_THROWS_AS(cache.get(1), std::runtime_error);
+    fail = false;
+    REQUIRE(cache.get(1).value() == "1");
+}
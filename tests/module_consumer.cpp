@@ -0,0 +1,38 @@
+//  Built only with `-DRESULT_BUILD_MODULE=ON`: checks that what the
+//  module exports can be named, and used, by an importer.
+import result;
+
+namespace {
+    auto parse(int v) -> result::Result<int, int> {
+        if (v < 0) {
+            return result::err(v);
+        }
+        return result::ok(v);
+    }
+}
+
+auto main(int, char const**) -> int {
+
+    result::Result<int, int> r = result::ok(20);
+    if (!r) {
+        return 1;
+    }
+
+    auto doubled = result::map(parse(20), [](int v) { return v * 2; });
+    auto checked = result::and_then(
+        result::Result<int, int> { doubled },
+        [](int v) { return parse(v + 2); });
+
+    if (!checked || checked.value() != 42) {
+        return 1;
+    }
+
+    auto failed = result::and_then(parse(-1), [](int v) {
+        return parse(v);
+    });
+
+    int seen = 0;
+    result::inspect_err(failed, [&seen](int e) { seen = e; });
+
+    return seen == -1 ? 0 : 1;
+}
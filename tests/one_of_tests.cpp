@@ -0,0 +1,227 @@
+#include "result/one_of.hpp"
+#include "result/result.hpp"
+#include "catch2/catch.hpp"
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+namespace {
+    enum class ParseError : uint8_t {
+        UnexpectedEnd,
+        BadToken
+    };
+
+    struct ProtocolError {
+        uint32_t code;
+        std::string detail;
+
+        friend auto operator==(ProtocolError const& lhs,
+                               ProtocolError const& rhs) -> bool
+        {
+            return lhs.code == rhs.code && lhs.detail == rhs.detail;
+        }
+    };
+
+    using AnyError = result::OneOf<std::error_code, ParseError, ProtocolError>;
+
+    auto read_bytes(bool fail) -> result::Result<size_t, std::error_code> {
+        if (fail) {
+            return result::err(std::make_error_code(std::errc::io_error));
+        }
+        return result::ok(size_t { 4 });
+    }
+
+    auto parse(size_t n) -> result::Result<int, ParseError> {
+        if (n < 8) {
+            return result::err(ParseError::UnexpectedEnd);
+        }
+        return result::ok(static_cast<int>(n));
+    }
+
+    auto load(bool fail_read) -> result::Result<int, AnyError> {
+        auto bytes = read_bytes(fail_read);
+        if (!bytes) {
+            return result::err(std::move(bytes).error());
+        }
+        return parse(bytes.value());
+    }
+
+    auto describe(AnyError const& e) -> std::string {
+        struct Describe {
+            auto operator()(std::error_code const&) const -> std::string {
+                return "io";
+            }
+            auto operator()(ParseError) const -> std::string {
+                return "parse";
+            }
+            auto operator()(ProtocolError const& p) const -> std::string {
+                return "protocol: " + p.detail;
+            }
+        };
+        return result::visit(Describe{}, e);
+    }
+}
+
+TEST_CASE("OneOf shares the Result's discriminant", "[one_of]") {
+
+    using R = result::Result<uint32_t, AnyError>;
+    static_assert(sizeof(R) == sizeof(AnyError),
+                  "the Result adds nothing to its OneOf error");
+
+    using Small = result::Result<uint16_t, result::OneOf<ParseError>>;
+    static_assert(sizeof(Small) == 2 * sizeof(uint16_t),
+                  "one tag byte, padded to the value's alignment");
+}
+
+TEST_CASE("Results widen into a OneOf", "[one_of]") {
+
+    auto io = load(true);
+    REQUIRE(!io);
+    REQUIRE(io.error().holds<std::error_code>());
+    REQUIRE(io.error().get<std::error_code>() == std::errc::io_error);
+    REQUIRE(describe(io.error()) == "io");
+
+    auto p = load(false);
+    REQUIRE(!p);
+    REQUIRE(p.error().index() == 1);
+    REQUIRE(p.error().get<ParseError>() == ParseError::UnexpectedEnd);
+    REQUIRE(p.error().get_if<std::error_code>() == nullptr);
+    REQUIRE_THROWS_AS(p.error().get<ProtocolError>(),
+                      result::BadResultAccess);
+
+    result::Result<int, result::OneOf<ParseError>> narrow =
+        parse(16);
+    result::Result<int, AnyError> wide = std::move(narrow);
+    REQUIRE(wide.value() == 16);
+
+    result::Result<int, result::OneOf<ParseError>> narrow_err =
+        parse(0);
+    result::Result<int, AnyError> wide_err = std::move(narrow_err);
+    REQUIRE(wide_err.error().get<ParseError>() == ParseError::UnexpectedEnd);
+
+    //  Other error conversions aren't implicit, only explicit.
+    static_assert(
+        !std::is_convertible<result::Result<int, int>&&,
+                             result::Result<int, long>>::value,
+        "only OneOf errors widen implicitly");
+    static_assert(
+        std::is_constructible<result::Result<int, long>,
+                              result::Result<int, int>&&>::value,
+        "other conversions can still be asked for");
+
+    auto code = result::Result<int, int> { result::err(3) };
+    auto widened = result::Result<int, long> { std::move(code) };
+    REQUIRE(widened.error() == 3L);
+}
+
+TEST_CASE("OneOf errors are copied, moved and compared", "[one_of]") {
+
+    using R = result::Result<std::string, AnyError>;
+
+    auto r = R { result::err(ProtocolError { 7, "bad frame" }) };
+    auto copy = r;
+    REQUIRE(copy == r);
+    REQUIRE(describe(copy.error()) == "protocol: bad frame");
+
+    auto moved = std::move(copy);
+    REQUIRE(moved.error().get<ProtocolError>().code == 7);
+
+    moved = R { result::ok(std::string { "payload" }) };
+    REQUIRE(moved.value() == "payload");
+    REQUIRE(moved != r);
+
+    auto mapped = std::move(r).map_err([](AnyError e) {
+        return e.visit([](auto const&) { return 1; });
+    });
+    REQUIRE(mapped.error() == 1);
+}
+
+TEST_CASE("Result<void, OneOf<...>>", "[one_of]") {
+
+    using R = result::Result<void, AnyError>;
+
+    auto ok = R { result::ok() };
+    REQUIRE(ok.is_ok());
+
+    auto failed = R { result::err(ParseError::BadToken) };
+    REQUIRE(failed.error().get<ParseError>() == ParseError::BadToken);
+
+    auto widened = R {
+        result::Result<void, std::error_code> {
+            result::err(std::make_error_code(std::errc::timed_out)) } };
+    REQUIRE(widened.error().get<std::error_code>() == std::errc::timed_out);
+}
+
+namespace {
+    struct Shape {
+        explicit Shape(std::string n) : name{std::move(n)}
+        { }
+
+        virtual ~Shape() = default;
+        virtual auto sides() const -> int { return 0; }
+
+        std::string name;
+    };
+
+    struct Square : Shape {
+        Square() : Shape{"square"}
+        { }
+
+        auto sides() const -> int override { return 4; }
+    };
+
+    struct CopyFails {
+        CopyFails() = default;
+        CopyFails(CopyFails&&) noexcept = default;
+        CopyFails(CopyFails const&) {
+            throw std::runtime_error { "no copies" };
+        }
+
+        friend auto operator==(CopyFails const&, CopyFails const&) -> bool {
+            return true;
+        }
+    };
+}
+
+TEST_CASE("OneOf moves don't throw when no alternative's do", "[one_of]") {
+
+    static_assert(std::is_nothrow_move_constructible<AnyError>::value,
+                  "OneOf moves are noexcept");
+    static_assert(
+        std::is_nothrow_move_constructible<
+            result::Result<std::string, AnyError>>::value,
+        "so a Result over one can be moved by std::vector");
+    static_assert(std::is_nothrow_move_assignable<AnyError>::value,
+                  "as is move assignment");
+}
+
+TEST_CASE("OneOf assignment keeps the target when a copy throws",
+          "[one_of]")
+{
+    using E = result::OneOf<ParseError, CopyFails>;
+
+    auto target = E { ParseError::BadToken };
+    auto source = E { CopyFails{} };
+    REQUIRE_THROWS_AS(target = source, std::runtime_error);
+    REQUIRE(target.get<ParseError>() == ParseError::BadToken);
+
+    target = std::move(source);
+    REQUIRE(target.holds<CopyFails>());
+}
+
+TEST_CASE("Results of polymorphic values hold OneOf errors", "[one_of]") {
+
+    using R = result::Result<Square, result::OneOf<ParseError>>;
+
+    auto r = R { result::ok(Square{}) };
+    auto copy = r;
+    Shape const& shape = copy.value();
+    REQUIRE(shape.sides() == 4);
+    REQUIRE(shape.name == "square");
+
+    copy = R { result::err(ParseError::BadToken) };
+    REQUIRE(!copy);
+    REQUIRE(copy.error() == result::OneOf<ParseError> { ParseError::BadToken });
+}
@@ -0,0 +1,185 @@
+#include "result/ranges.hpp"
+#include "result/result.hpp"
+#include "catch2/catch.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    using R = result::Result<int, std::string>;
+
+    auto make_records() -> std::vector<R> {
+        std::vector<R> records;
+        records.push_back(result::ok(1));
+        records.push_back(result::ok(2));
+        records.push_back(result::err(std::string { "bad 3" }));
+        records.push_back(result::ok(4));
+        records.push_back(result::err(std::string { "bad 5" }));
+        return records;
+    }
+
+    template<typename Range>
+    auto collect(Range&& r) {
+        std::vector<typename std::decay<decltype(*std::begin(r))>::type> out;
+        for (auto&& item : r) {
+            out.push_back(item);
+        }
+        return out;
+    }
+}
+
+TEST_CASE("filter_ok", "[ranges]") {
+
+    auto records = make_records();
+
+    REQUIRE(collect(result::filter_ok(records)) ==
+            (std::vector<int> { 1, 2, 4 }));
+
+    REQUIRE(collect(result::filter_ok(records.begin(), records.end())) ==
+            (std::vector<int> { 1, 2, 4 }));
+
+    REQUIRE(collect(records | result::filter_ok()) ==
+            (std::vector<int> { 1, 2, 4 }));
+
+    for (auto& v : records | result::filter_ok()) {
+        v *= 10;
+    }
+
+    REQUIRE(records[3].value() == 40);
+}
+
+TEST_CASE("errors_only", "[ranges]") {
+
+    auto records = make_records();
+
+    REQUIRE(collect(records | result::errors_only()) ==
+            (std::vector<std::string> { "bad 3", "bad 5" }));
+}
+
+TEST_CASE("take_while_ok", "[ranges]") {
+
+    auto records = make_records();
+
+    REQUIRE(collect(records | result::take_while_ok()) ==
+            (std::vector<int> { 1, 2 }));
+
+    std::vector<R> empty;
+    REQUIRE(collect(empty | result::take_while_ok()).empty());
+}
+
+TEST_CASE("transform_ok", "[ranges]") {
+
+    auto records = make_records();
+
+    auto mapped = records
+        | result::transform_ok([](int v) { return std::to_string(v * 2); });
+
+    auto out = collect(mapped);
+    REQUIRE(out.size() == 5);
+    REQUIRE(out[0].value() == "2");
+    REQUIRE(out[2].error() == "bad 3");
+
+    REQUIRE(collect(mapped | result::filter_ok()) ==
+            (std::vector<std::string> { "2", "4", "8" }));
+}
+
+TEST_CASE("and_then_each", "[ranges]") {
+
+    auto records = make_records();
+
+    auto checked = records
+        | result::and_then_each([](int v) -> R {
+            if (v % 2) {
+                return result::err(std::string { "odd" });
+            }
+            return result::ok(v);
+        });
+
+    REQUIRE(collect(checked | result::errors_only()) ==
+            (std::vector<std::string> { "odd", "bad 3", "bad 5" }));
+
+    REQUIRE(collect(checked | result::take_while_ok()).empty());
+}
+
+TEST_CASE("Adaptors evaluate lazily", "[ranges]") {
+
+    auto records = make_records();
+    size_t calls = 0;
+
+    auto mapped = result::transform_ok(records, [&calls](int v) {
+        ++calls;
+        return v;
+    });
+
+    REQUIRE(calls == 0);
+
+    auto it = mapped.begin();
+    REQUIRE((*it).value() == 1);
+    REQUIRE(calls == 1);
+}
+
+TEST_CASE("Adaptors yield move-only values by value from prvalues",
+          "[ranges]")
+{
+    using P = result::Result<std::unique_ptr<int>, std::string>;
+    std::vector<P> records;
+    records.push_back(result::ok(std::make_unique<int>(1)));
+
+    auto owned = records
+        | result::transform_ok([](std::unique_ptr<int>& p) {
+            return std::make_unique<int>(*p + 1);
+        })
+        | result::filter_ok();
+
+    for (auto p : owned) {
+        REQUIRE(*p == 2);
+    }
+}
+
+TEST_CASE("Chained adaptors call f once per element", "[ranges]") {
+
+    auto records = make_records();
+    size_t calls = 0;
+
+    auto doubled = records
+        | result::transform_ok([&calls](int v) {
+            ++calls;
+            return v * 2;
+        });
+
+    REQUIRE(collect(doubled | result::filter_ok()) ==
+            (std::vector<int> { 2, 4, 8 }));
+    REQUIRE(calls == 3);
+
+    calls = 0;
+    auto it = (doubled | result::take_while_ok()).begin();
+    REQUIRE(*it == 2);
+    REQUIRE(*it == 2);
+    REQUIRE(calls == 1);
+
+    calls = 0;
+    auto checked = records
+        | result::and_then_each([&calls](int v) -> R {
+            ++calls;
+            return result::err(std::to_string(v));
+        });
+
+    REQUIRE(collect(checked | result::errors_only()) ==
+            (std::vector<std::string> { "1", "2", "bad 3", "4", "bad 5" }));
+    REQUIRE(calls == 3);
+}
+
+TEST_CASE("Adaptors keep temporary containers alive", "[ranges]") {
+
+    REQUIRE(collect(result::filter_ok(make_records())) ==
+            (std::vector<int> { 1, 2, 4 }));
+
+    auto errors = make_records() | result::errors_only();
+    REQUIRE(collect(errors) ==
+            (std::vector<std::string> { "bad 3", "bad 5" }));
+
+    auto bumped = make_records()
+        | result::transform_ok([](int v) { return v + 1; })
+        | result::take_while_ok();
+    REQUIRE(collect(bumped) == (std::vector<int> { 2, 3 }));
+}
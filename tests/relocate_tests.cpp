@@ -0,0 +1,154 @@
+#include "result/relocate.hpp"
+#include "result/result.hpp"
+#include "catch2/catch.hpp"
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+namespace {
+    struct Tracked {
+        Tracked(int v) : value{v} { ++alive; }
+        Tracked(Tracked&& other) noexcept : value{other.value} {
+            ++alive;
+            ++moves;
+        }
+        Tracked(Tracked const& other) : value{other.value} { ++alive; }
+        ~Tracked() { --alive; }
+
+        auto operator=(Tracked&& other) noexcept -> Tracked& {
+            value = other.value;
+            return *this;
+        }
+
+        int value;
+        static int alive;
+        static int moves;
+    };
+
+    int Tracked::alive = 0;
+    int Tracked::moves = 0;
+
+    //  Its move may throw, so it's copied; the `fail_at`th copy
+    //  throws.
+    struct Fragile {
+        Fragile(int v) : value{v} { ++alive; }
+        Fragile(Fragile&& other) : Fragile{other} { }
+        Fragile(Fragile const& other) : value{other.value} {
+            if (fail_at && --fail_at == 0) {
+                throw std::runtime_error { "copy failed" };
+            }
+            ++alive;
+        }
+        ~Fragile() { --alive; }
+
+        int value;
+        static int alive;
+        static int fail_at;
+    };
+
+    int Fragile::alive = 0;
+    int Fragile::fail_at = 0;
+}
+
+TEST_CASE("Result is trivially relocatable when T and E are",
+          "[relocate]")
+{
+    using namespace result::traits;
+
+    REQUIRE(
+        is_trivially_relocatable<
+            result::Result<size_t, std::error_code>>::value);
+    REQUIRE(
+        is_trivially_relocatable<
+            result::Result<std::unique_ptr<int>, std::error_code>>::value);
+    REQUIRE(
+        is_trivially_relocatable<
+            result::Result<void, std::error_code>>::value);
+    REQUIRE(
+        !is_trivially_relocatable<
+            result::Result<Tracked, std::error_code>>::value);
+}
+
+TEST_CASE("RelocatingVector grows and erases relocatable Results",
+          "[relocate]")
+{
+    using R = result::Result<std::unique_ptr<int>, std::error_code>;
+
+    result::RelocatingVector<R> v;
+    for (int i = 0; i < 100; ++i) {
+        if (i % 10 == 0) {
+            v.push_back(result::err(
+                std::make_error_code(std::errc::invalid_argument)));
+        }
+        else {
+            v.push_back(result::ok(std::make_unique<int>(i)));
+        }
+    }
+
+    REQUIRE(v.size() == 100);
+    REQUIRE(*v[99].value() == 99);
+    REQUIRE(!v[50].is_ok());
+
+    auto it = v.erase(v.begin() + 1);
+    REQUIRE(v.size() == 99);
+    REQUIRE(*it->value() == 2);
+    REQUIRE(*v.back().value() == 99);
+}
+
+TEST_CASE("RelocatingVector falls back to move and destroy",
+          "[relocate]")
+{
+    Tracked::moves = 0;
+
+    {
+        result::RelocatingVector<Tracked> v;
+        for (int i = 0; i < 9; ++i) {
+            v.emplace_back(i);
+        }
+
+        REQUIRE(Tracked::alive == 9);
+        REQUIRE(Tracked::moves > 0);
+
+        v.erase(v.begin());
+        REQUIRE(Tracked::alive == 8);
+        REQUIRE(v[0].value == 1);
+        REQUIRE(v[7].value == 8);
+    }
+
+    REQUIRE(Tracked::alive == 0);
+}
+
+TEST_CASE("RelocatingVector keeps its elements when a copy throws",
+          "[relocate]")
+{
+    {
+        result::RelocatingVector<Fragile> v;
+        for (int i = 0; i < 4; ++i) {
+            v.emplace_back(i);
+        }
+
+        //  Growing copies all four; the third copy fails.
+        Fragile::fail_at = 3;
+        REQUIRE_THROWS_AS(v.emplace_back(4), std::runtime_error);
+        REQUIRE(v.size() == 4);
+        REQUIRE(v.capacity() == 4);
+        REQUIRE(Fragile::alive == 4);
+        REQUIRE(v[3].value == 3);
+
+        Fragile::fail_at = 2;
+        REQUIRE_THROWS_AS(v.reserve(16), std::runtime_error);
+        REQUIRE(v.size() == 4);
+        REQUIRE(Fragile::alive == 4);
+
+        //  Erasing shifts by copying; the second copy fails, and the
+        //  elements from there on are dropped.
+        Fragile::fail_at = 2;
+        REQUIRE_THROWS_AS(v.erase(v.begin()), std::runtime_error);
+        REQUIRE(v.size() == 1);
+        REQUIRE(v[0].value == 1);
+        REQUIRE(Fragile::alive == 1);
+    }
+
+    REQUIRE(Fragile::alive == 0);
+}
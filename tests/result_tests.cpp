@@ -165,7 +165,7 @@ TEST_CASE("Should implicity cast results to bool") {
     R result = result::ok();
 
     if (auto& r = result) {
-        REQUIRE(true);
+        REQUIRE(r.is_ok());
         return;
     }
 
@@ -264,7 +264,7 @@ TEST_CASE("and_then") {
         auto r1 = result::and_then(std::move(r), [](auto int_val) {
             return result::ok(std::to_string(int_val * 2));
         })
-        .and_then([](auto str_val) {
+        .and_then([](auto) {
             return result::err(42ul); //str_val + " - Hello");
         });
 
@@ -304,3 +304,118 @@ TEST_CASE("value_or_else") {
         REQUIRE(val == 41);
     }
 }
+
+namespace {
+    struct MoveCounter {
+        explicit MoveCounter(int& moves) noexcept :
+            moves_{&moves}
+        { }
+
+        MoveCounter(MoveCounter&& other) noexcept :
+            moves_{other.moves_}
+        {
+            ++*moves_;
+        }
+
+        MoveCounter(MoveCounter const&) = delete;
+
+        int* moves_;
+    };
+}
+
+TEST_CASE("flatten", "[result]") {
+    using result::Result;
+
+    using Inner = Result<std::string, int>;
+    using Nested = Result<Result<Inner, int>, int>;
+
+    {
+        auto r = Nested { result::ok(Result<Inner, int> {
+            result::ok(Inner { result::ok(std::string { "deep" }) }) }) };
+        auto flat = result::flatten(std::move(r));
+        static_assert(
+            std::is_same<decltype(flat), Inner>::value,
+            "flatten() should collapse every level");
+        REQUIRE(flat.value() == "deep");
+    }
+
+    {
+        auto r = Nested { result::ok(Result<Inner, int> {
+            result::ok(Inner { result::err(3) }) }) };
+        REQUIRE(result::flatten(std::move(r)).error() == 3);
+    }
+
+    {
+        auto r = Nested { result::err(1) };
+        REQUIRE(result::flatten(std::move(r)).error() == 1);
+    }
+
+    {
+        using VoidNested = Result<Result<void, int>, int>;
+        auto r = VoidNested { result::ok(Result<void, int> { result::ok() }) };
+        REQUIRE(std::move(r).flatten().is_ok());
+    }
+
+    {
+        int moves = 0;
+        using Counted = Result<MoveCounter, int>;
+        auto r = Result<Result<Counted, int>, int> {
+            result::ok(Result<Counted, int> {
+                result::ok(Counted { result::ok(MoveCounter { moves }) })
+            })
+        };
+
+        moves = 0;
+        auto flat = std::move(r).flatten();
+        REQUIRE(flat.is_ok());
+        REQUIRE(moves == 1);
+    }
+}
+
+TEST_CASE("join", "[result]") {
+    using result::Result;
+
+    using Nested = Result<int, Result<int, Result<int, std::string>>>;
+    using Middle = Result<int, Result<int, std::string>>;
+
+    {
+        auto r = Nested { result::ok(1) };
+        auto joined = result::join(std::move(r));
+        static_assert(
+            std::is_same<decltype(joined), Result<int, std::string>>::value,
+            "join() should collapse every level");
+        REQUIRE(joined.value() == 1);
+    }
+
+    {
+        auto r = Nested { result::err(Middle { result::ok(2) }) };
+        REQUIRE(result::join(std::move(r)).value() == 2);
+    }
+
+    {
+        auto r = Nested { result::err(Middle { result::err(
+            Result<int, std::string> { result::err(std::string { "e" }) }) }) };
+        REQUIRE(std::move(r).join().error() == "e");
+    }
+
+    {
+        auto r = Result<void, Result<void, int>> {
+            result::err(Result<void, int> { result::err(5) }) };
+        REQUIRE(std::move(r).join().error() == 5);
+    }
+}
+
+TEST_CASE("Smart pointers are relocatable without relocate.hpp",
+          "[result]")
+{
+    //  This file doesn't include `result/relocate.hpp`; the answer
+    //  must match the one `RelocatingVector` sees.
+    static_assert(
+        result::traits::is_trivially_relocatable<
+            result::Result<std::unique_ptr<int>, std::error_code>>::value,
+        "unique_ptr is relocatable wherever the trait is visible");
+    static_assert(
+        result::traits::is_trivially_relocatable<
+            std::shared_ptr<int>>::value,
+        "shared_ptr is relocatable wherever the trait is visible");
+}
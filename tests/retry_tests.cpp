@@ -0,0 +1,227 @@
+#include "result/retry.hpp"
+#include "result/result.hpp"
+#include "catch2/catch.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <vector>
+
+namespace {
+    struct FakeTimer {
+        using clock = std::chrono::steady_clock;
+        using duration = std::chrono::microseconds;
+        using time_point = std::chrono::time_point<clock, duration>;
+
+        static auto now() -> time_point { return current; }
+
+        static auto sleep_for(duration d) -> void {
+            sleeps.push_back(d);
+            current += d;
+        }
+
+        static auto reset() -> void {
+            current = time_point {};
+            sleeps.clear();
+        }
+
+        static time_point current;
+        static std::vector<duration> sleeps;
+    };
+
+    FakeTimer::time_point FakeTimer::current {};
+    std::vector<FakeTimer::duration> FakeTimer::sleeps {};
+
+    using IoResult = result::Result<size_t, std::error_code>;
+
+    auto is_transient(std::error_code const& ec) -> bool {
+        return ec == std::errc::resource_unavailable_try_again;
+    }
+
+    auto transient() -> IoResult {
+        return result::err(std::make_error_code(
+            std::errc::resource_unavailable_try_again));
+    }
+
+    auto policy() {
+        auto p = result::retry_policy<FakeTimer>(is_transient);
+        p.initial_backoff = std::chrono::milliseconds { 10 };
+        p.max_backoff = std::chrono::milliseconds { 40 };
+        p.jitter = 0.0;
+        p.seed = 1;
+        return p;
+    }
+}
+
+TEST_CASE("retry stops on success", "[retry]") {
+
+    FakeTimer::reset();
+    size_t calls = 0;
+
+    auto r = result::retry(policy(), [&]() -> IoResult {
+        if (++calls < 3) {
+            return transient();
+        }
+        return result::ok(calls);
+    });
+
+    REQUIRE(r.value() == 3);
+    REQUIRE(FakeTimer::sleeps.size() == 2);
+    REQUIRE(FakeTimer::sleeps[0] == std::chrono::milliseconds { 10 });
+    REQUIRE(FakeTimer::sleeps[1] == std::chrono::milliseconds { 20 });
+}
+
+TEST_CASE("retry gives up on permanent errors", "[retry]") {
+
+    FakeTimer::reset();
+    size_t calls = 0;
+
+    auto r = result::retry(policy(), [&]() -> IoResult {
+        ++calls;
+        return result::err(
+            std::make_error_code(std::errc::permission_denied));
+    });
+
+    REQUIRE(r.error() == std::errc::permission_denied);
+    REQUIRE(calls == 1);
+    REQUIRE(FakeTimer::sleeps.empty());
+}
+
+TEST_CASE("retry caps backoff and attempts", "[retry]") {
+
+    FakeTimer::reset();
+    size_t calls = 0;
+
+    auto r = result::retry(policy(), [&] {
+        ++calls;
+        return transient();
+    });
+
+    REQUIRE(!r.is_ok());
+    REQUIRE(calls == 5);
+    REQUIRE(FakeTimer::sleeps.size() == 4);
+    REQUIRE(FakeTimer::sleeps[3] == std::chrono::milliseconds { 40 });
+}
+
+TEST_CASE("retry respects the deadline", "[retry]") {
+
+    FakeTimer::reset();
+    size_t calls = 0;
+
+    auto p = policy();
+    p.max_attempts = 100;
+    p.deadline = std::chrono::milliseconds { 35 };
+
+    auto r = result::retry(p, [&] {
+        ++calls;
+        return transient();
+    });
+
+    //  10ms + 20ms of backoff fit, the next 40ms doesn't.
+    REQUIRE(!r.is_ok());
+    REQUIRE(calls == 3);
+    REQUIRE(FakeTimer::now().time_since_epoch() <=
+            std::chrono::milliseconds { 35 });
+}
+
+TEST_CASE("retry applies jitter deterministically", "[retry]") {
+
+    auto p = policy();
+    p.jitter = 0.5;
+
+    FakeTimer::reset();
+    result::retry(p, transient);
+    auto first = FakeTimer::sleeps;
+
+    FakeTimer::reset();
+    result::retry(p, transient);
+
+    REQUIRE(first == FakeTimer::sleeps);
+    for (auto d : first) {
+        REQUIRE(d <= std::chrono::milliseconds { 40 });
+        REQUIRE(d >= std::chrono::milliseconds { 5 });
+    }
+}
+
+TEST_CASE("hedge returns the faster attempt", "[retry]") {
+
+    //  Shared, since the slower attempt is still running when
+    //  `hedge` returns.
+    struct Gate {
+        std::mutex mutex;
+        std::condition_variable released;
+        bool release = false;
+        std::atomic<int> calls { 0 };
+    };
+    auto gate = std::make_shared<Gate>();
+    result::ThreadPool pool { 2 };
+
+    auto r = result::hedge(pool, [gate]() -> IoResult {
+        if (gate->calls++ == 0) {
+            std::unique_lock<std::mutex> lock { gate->mutex };
+            gate->released.wait(lock, [&] { return gate->release; });
+            return result::ok(size_t { 1 });
+        }
+        return result::ok(size_t { 2 });
+    }, std::chrono::milliseconds { 1 });
+
+    REQUIRE(r.value() == 2);
+
+    {
+        std::lock_guard<std::mutex> lock { gate->mutex };
+        gate->release = true;
+    }
+    gate->released.notify_all();
+}
+
+TEST_CASE("hedge doesn't start a second attempt when the first is quick",
+          "[retry]")
+{
+    std::atomic<int> calls { 0 };
+    result::ThreadPool pool { 2 };
+
+    auto r = result::hedge(pool, [&]() -> IoResult {
+        ++calls;
+        return result::ok(size_t { 1 });
+    }, std::chrono::seconds { 10 });
+
+    REQUIRE(r.value() == 1);
+    REQUIRE(calls == 1);
+}
+
+TEST_CASE("hedge on the default pool starts the second attempt", "[retry]") {
+
+    //  Shared, since the blocked first attempt outlives this test on
+    //  the default pool's worker.
+    struct Gate {
+        std::mutex mutex;
+        std::condition_variable released;
+        bool release = false;
+        std::atomic<int> calls { 0 };
+    };
+    auto gate = std::make_shared<Gate>();
+
+    auto start = std::chrono::steady_clock::now();
+    auto r = result::hedge([gate]() -> IoResult {
+        if (gate->calls++ == 0) {
+            std::unique_lock<std::mutex> lock { gate->mutex };
+            gate->released.wait_for(lock,
+                                    std::chrono::seconds { 5 },
+                                    [&] { return gate->release; });
+            return result::ok(size_t { 1 });
+        }
+        return result::ok(size_t { 2 });
+    }, std::chrono::milliseconds { 10 });
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    REQUIRE(r.value() == 2);
+    REQUIRE(elapsed < std::chrono::seconds { 1 });
+
+    {
+        std::lock_guard<std::mutex> lock { gate->mutex };
+        gate->release = true;
+    }
+    gate->released.notify_all();
+}
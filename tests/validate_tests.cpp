@@ -0,0 +1,177 @@
+#include "result/validate.hpp"
+#include "result/result.hpp"
+#include "catch2/catch.hpp"
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+namespace {
+    size_t allocations = 0;
+
+    template<typename T>
+    struct CountingAllocator {
+        using value_type = T;
+
+        CountingAllocator() = default;
+
+        template<typename U>
+        CountingAllocator(CountingAllocator<U> const&) noexcept
+        { }
+
+        auto allocate(size_t n) -> T* {
+            ++allocations;
+            return std::allocator<T>{}.allocate(n);
+        }
+
+        auto deallocate(T* p, size_t n) noexcept -> void {
+            std::allocator<T>{}.deallocate(p, n);
+        }
+
+        template<typename U>
+        friend auto operator==(CountingAllocator const&,
+                               CountingAllocator<U> const&) -> bool
+        {
+            return true;
+        }
+
+        template<typename U>
+        friend auto operator!=(CountingAllocator const&,
+                               CountingAllocator<U> const&) -> bool
+        {
+            return false;
+        }
+    };
+
+    using Field = result::Result<int, std::string>;
+
+    auto field_ok(int v) -> Field {
+        return result::ok(v);
+    }
+
+    auto field_err(char const* msg) -> Field {
+        return result::err(std::string { msg });
+    }
+}
+
+TEST_CASE("validate collects values when all succeed", "[validate]") {
+
+    auto name = result::Result<std::string, std::string> {
+        result::ok(std::string { "alice" }) };
+
+    auto r = result::validate(field_ok(1), std::move(name), field_ok(3));
+
+    REQUIRE(r.is_ok());
+    REQUIRE(std::get<0>(r.value()) == 1);
+    REQUIRE(std::get<1>(r.value()) == "alice");
+    REQUIRE(std::get<2>(r.value()) == 3);
+}
+
+TEST_CASE("validate collects every error in order", "[validate]") {
+
+    auto r = result::validate(
+        field_err("first"), field_ok(2), field_err("third"));
+
+    REQUIRE(!r.is_ok());
+    REQUIRE(r.error().size() == 2);
+    REQUIRE(r.error()[0] == "first");
+    REQUIRE(r.error()[1] == "third");
+}
+
+TEST_CASE("validate allocates at most once", "[validate]") {
+
+    CountingAllocator<std::string> alloc;
+
+    allocations = 0;
+    auto few = result::validate(
+        std::allocator_arg, alloc, field_err("a"), field_err("b"));
+    REQUIRE(few.error().size() == 2);
+    REQUIRE(allocations == 0);
+
+    auto many = result::validate(
+        std::allocator_arg,
+        alloc,
+        field_err("a"),
+        field_err("b"),
+        field_err("c"),
+        field_err("d"),
+        field_err("e"),
+        field_err("f"));
+
+    REQUIRE(many.error().size() == 6);
+    REQUIRE(many.error()[5] == "f");
+    REQUIRE(allocations == 1);
+}
+
+TEST_CASE("ErrorList spills out of line and can be copied", "[validate]") {
+
+    result::ErrorList<int, 2> errors;
+    for (int i = 0; i < 10; ++i) {
+        errors.push_back(i);
+    }
+
+    REQUIRE(errors.size() == 10);
+    REQUIRE(errors.capacity() >= 10);
+
+    auto copy = errors;
+    REQUIRE(copy == errors);
+
+    auto moved = std::move(copy);
+    REQUIRE(moved == errors);
+    REQUIRE(copy.empty());
+}
+
+namespace {
+    //  Copies throw once `budget` runs out.
+    struct Costly {
+        Costly(int v) : value{v} { }
+        Costly(Costly&&) noexcept = default;
+        Costly(Costly const& other) : value{other.value} {
+            if (budget-- == 0) {
+                throw std::runtime_error { "out of budget" };
+            }
+        }
+        auto operator=(Costly const&) -> Costly& = default;
+
+        friend auto operator==(Costly const& lhs, Costly const& rhs)
+            -> bool
+        {
+            return lhs.value == rhs.value;
+        }
+
+        int value;
+        static int budget;
+    };
+
+    int Costly::budget = 0;
+}
+
+TEST_CASE("ErrorList assignment is exception safe", "[validate]") {
+
+    result::ErrorList<Costly, 2> target;
+    target.push_back(Costly { 1 });
+
+    result::ErrorList<Costly, 2> source;
+    for (int i = 0; i < 5; ++i) {
+        source.push_back(Costly { 10 + i });
+    }
+
+    Costly::budget = 3;
+    REQUIRE_THROWS_AS(target = source, std::runtime_error);
+    REQUIRE(target.size() == 1);
+    REQUIRE(target[0].value == 1);
+
+    Costly::budget = 5;
+    target = source;
+    REQUIRE(target == source);
+
+    result::ErrorList<Costly, 2> small;
+    small.push_back(Costly { 7 });
+    target = std::move(small);
+    REQUIRE(target.size() == 1);
+    REQUIRE(target[0].value == 7);
+
+    target = std::move(source);
+    REQUIRE(target.size() == 5);
+    REQUIRE(source.empty());
+}
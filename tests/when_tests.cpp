@@ -0,0 +1,146 @@
+#include "result/when.hpp"
+#include "result/result.hpp"
+#include "catch2/catch.hpp"
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace {
+    using Config = result::Result<std::string, int>;
+    using Dictionary = result::Result<std::vector<int>, int>;
+    using Index = result::Result<size_t, int>;
+}
+
+TEST_CASE("when_all gathers heterogeneous values", "[when]") {
+
+    result::WorkStealingPool pool { 4 };
+
+    auto r = result::when_all(
+        pool,
+        []() -> Config { return result::ok(std::string { "config" }); },
+        []() -> Dictionary { return result::ok(std::vector<int> { 1, 2 }); },
+        [](result::CancellationToken const&) -> Index {
+            return result::ok(size_t { 42 });
+        });
+
+    REQUIRE(r.is_ok());
+    REQUIRE(std::get<0>(r.value()) == "config");
+    REQUIRE(std::get<1>(r.value()).size() == 2);
+    REQUIRE(std::get<2>(r.value()) == 42);
+}
+
+TEST_CASE("when_all returns the first error and cancels the rest",
+          "[when]")
+{
+    std::atomic<bool> saw_cancellation { false };
+    std::atomic<bool> finished { false };
+
+    {
+        result::WorkStealingPool pool { 2 };
+
+        auto r = result::when_all(
+            pool,
+            [&](result::CancellationToken const& token) -> Index {
+                auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::seconds { 5 };
+                while (!token.is_cancelled() &&
+                       std::chrono::steady_clock::now() < deadline)
+                {
+                    std::this_thread::yield();
+                }
+                saw_cancellation = token.is_cancelled();
+                finished = true;
+                return result::ok(size_t { 1 });
+            },
+            []() -> Config { return result::err(7); });
+
+        REQUIRE(r.error() == 7);
+    }
+
+    REQUIRE(finished);
+    REQUIRE(saw_cancellation);
+}
+
+TEST_CASE("when_all runs nested fan-outs without deadlocking", "[when]") {
+
+    result::WorkStealingPool pool { 1 };
+
+    auto r = result::when_all(
+        pool,
+        [&pool]() -> Index {
+            auto inner = result::when_all(
+                pool,
+                []() -> Index { return result::ok(size_t { 1 }); },
+                []() -> Index { return result::ok(size_t { 2 }); });
+            return result::ok(std::get<0>(inner.value()) +
+                              std::get<1>(inner.value()));
+        },
+        []() -> Index { return result::ok(size_t { 3 }); });
+
+    REQUIRE(std::get<0>(r.value()) == 3);
+    REQUIRE(std::get<1>(r.value()) == 3);
+}
+
+TEST_CASE("when_any returns the first success", "[when]") {
+
+    result::WorkStealingPool pool { 2 };
+
+    auto r = result::when_any(
+        pool,
+        []() -> Index { return result::err(1); },
+        []() -> Index { return result::ok(size_t { 5 }); },
+        []() -> Index { return result::err(3); });
+
+    REQUIRE(r.value() == 5);
+}
+
+TEST_CASE("when_any fails when every task does", "[when]") {
+
+    result::WorkStealingPool pool { 2 };
+
+    auto r = result::when_any(
+        pool,
+        []() -> Index { return result::err(1); },
+        []() -> Index { return result::err(1); });
+
+    REQUIRE(r.error() == 1);
+}
+
+TEST_CASE("when_all rethrows a task's exception", "[when]") {
+
+    result::WorkStealingPool pool { 2 };
+
+    REQUIRE_THROWS_AS(
+        result::when_all(
+            pool,
+            []() -> Index { throw std::runtime_error { "boom" }; },
+            []() -> Config { return result::ok(std::string { "x" }); }),
+        std::runtime_error);
+
+    //  The pool's workers survive it.
+    auto r = result::when_all(
+        pool,
+        []() -> Index { return result::ok(size_t { 1 }); });
+    REQUIRE(std::get<0>(r.value()) == 1);
+}
+
+TEST_CASE("when_any rethrows only when nothing succeeds", "[when]") {
+
+    result::WorkStealingPool pool { 2 };
+
+    auto r = result::when_any(
+        pool,
+        []() -> Index { throw std::runtime_error { "boom" }; },
+        []() -> Index { return result::ok(size_t { 7 }); });
+    REQUIRE(r.value() == 7);
+
+    REQUIRE_THROWS_AS(
+        result::when_any(
+            pool,
+            []() -> Index { throw std::runtime_error { "boom" }; }),
+        std::runtime_error);
+}